@@ -6,6 +6,76 @@
 // ----------------------------------------------------------------------------
 
 #include "ClickEncoder.h"
+#include "ClickEncoderTrace.h"
+
+// ----------------------------------------------------------------------------
+
+void InputFilter::configure(uint8_t depth, uint8_t threshold, bool level)
+{
+    state = level;
+    depth = (depth < 1) ? 1 : ((depth > 8) ? 8 : depth);
+    this->threshold = (threshold < 1) ? 1 : ((threshold > depth) ? depth : threshold);
+    // all ones in the lowest "depth" bits
+    sampleMask = static_cast<uint8_t>(0xFF >> (8 - depth));
+    samples = state ? sampleMask : 0;
+}
+
+void InputFilter::reset(bool level)
+{
+    state = level;
+    samples = state ? sampleMask : 0;
+}
+
+bool InputFilter::filter(bool sample)
+{
+    samples = ((samples << 1) | sample) & sampleMask;
+    // "ones" are votes for active, zeroes within mask are votes for inactive
+    uint8_t votes = state ? countOnes(samples ^ sampleMask) : countOnes(samples);
+    if (votes >= threshold)
+    {
+        state = !state;
+        // start over so the new state has to be outvoted again
+        samples = state ? sampleMask : 0;
+    }
+    return state;
+}
+
+uint8_t InputFilter::countOnes(uint8_t samples)
+{
+    static const uint8_t ONES_PER_NIBBLE[16]{0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+    return ONES_PER_NIBBLE[samples & 0x0F] + ONES_PER_NIBBLE[samples >> 4];
+}
+
+// ----------------------------------------------------------------------------
+
+volatile bool InputActivity::pending{false};
+volatile uint8_t InputActivity::sequence{0};
+volatile uint8_t InputActivity::busyCount{0};
+void (*InputActivity::idleCallback)(){nullptr};
+
+void InputActivity::notify()
+{
+    ++sequence;
+    pending = true;
+}
+
+void InputActivity::setBusy(volatile bool &instanceBusy, bool isBusy)
+{
+    if (instanceBusy == isBusy)
+    {
+        return;
+    }
+
+    instanceBusy = isBusy;
+    if (isBusy)
+    {
+        ++busyCount;
+    }
+    else if ((--busyCount == 0) && idleCallback)
+    {
+        idleCallback();
+    }
+}
 
 // ----------------------------------------------------------------------------
 
@@ -21,8 +91,38 @@ Encoder::Encoder(uint8_t A,
                                 pinActiveState(active)
 {
     uint8_t configType = (pinActiveState == LOW) ? INPUT_PULLUP : INPUT;
-    pinMode(pinA, configType);
-    pinMode(pinB, configType);
+    if (pinA != ENC_NOPIN)
+    {
+        pinMode(pinA, configType);
+        pinMode(pinB, configType);
+    }
+
+    // power of 2 steps per notch: convert to fixed point by shifting only
+    if ((stepsPerNotch & (stepsPerNotch - 1)) == 0)
+    {
+        fixedPointShift = 8;
+        for (uint8_t steps = stepsPerNotch; steps > 1; steps >>= 1)
+        {
+            --fixedPointShift;
+        }
+    }
+}
+
+// Encoder without own pins, fed via ::service(levelA, levelB) or ::update(levelA, levelB)
+Encoder::Encoder(SampledElsewhere, uint8_t stepsPerNotch, bool active) : Encoder(ENC_NOPIN, ENC_NOPIN, stepsPerNotch, active)
+{
+}
+
+Encoder::~Encoder()
+{
+    InputActivity::setBusy(busy, false);
+}
+
+void Encoder::setInputFilter(uint8_t depth, uint8_t threshold)
+{
+    // without pins, start with the levels sampled last
+    filterA.configure(depth, threshold, (pinA == ENC_NOPIN) ? filterA.getState() : digitalRead(pinA));
+    filterB.configure(depth, threshold, (pinB == ENC_NOPIN) ? filterB.getState() : digitalRead(pinB));
 }
 
 // Button pin BTN and active state to be defined.
@@ -31,9 +131,91 @@ Button::Button(uint8_t BTN,
                               pinActiveState(active)
 {
     uint8_t configType = (pinActiveState == LOW) ? INPUT_PULLUP : INPUT;
-    pinMode(pinBTN, configType);
+    if (pinBTN != ENC_NOPIN)
+    {
+        pinMode(pinBTN, configType);
+    }
+}
+
+// Button without own pin, fed via ::service(level)
+Button::Button(SampledElsewhere, bool active) : Button(ENC_NOPIN, active)
+{
+}
+
+Button::~Button()
+{
+    InputActivity::setBusy(busy, false);
+}
+
+void Button::setInputFilter(uint8_t depth, uint8_t threshold)
+{
+    filterBTN.configure(depth, threshold, (pinBTN == ENC_NOPIN) ? filterBTN.getState() : digitalRead(pinBTN));
 }
 
+// ----------------------------------------------------------------------------
+// Gesture tables
+namespace
+{
+using G = GestureEngine;
+
+// ClickEncoder: button edges and notches turned while pressed
+enum eClickEvents : uint8_t
+{
+    Press = 0,
+    Release,
+    Turn
+};
+enum eClickStates : uint8_t
+{
+    ClickIdle = 0,
+    Down1,
+    Up1,
+    Down2,
+    Up2,
+    Down3,
+    Holding,
+    Turning,
+    ClickStates
+};
+constexpr uint8_t CLICK_TRANSITIONS[ClickStates][G::EVENTS]{
+    //            Press                    Release                                  Turn                                       Timeout
+    /* Idle    */ {G::transition(Down1),   G::transition(ClickIdle),                G::transition(ClickIdle),                  G::transition(ClickIdle)},
+    /* Down1   */ {G::transition(Down1),   G::transition(Up1),                      G::transition(Turning, G::PressAndTurn),   G::transition(Holding, G::Hold)},
+    /* Up1     */ {G::transition(Down2),   G::transition(Up1),                      G::transition(ClickIdle, G::Click),        G::transition(ClickIdle, G::Click)},
+    /* Down2   */ {G::transition(Down2),   G::transition(Up2),                      G::transition(Turning, G::PressAndTurn),   G::transition(Holding, G::Hold)},
+    /* Up2     */ {G::transition(Down3),   G::transition(Up2),                      G::transition(ClickIdle, G::DoubleClick),  G::transition(ClickIdle, G::DoubleClick)},
+    /* Down3   */ {G::transition(Down3),   G::transition(ClickIdle, G::TripleClick), G::transition(Turning, G::PressAndTurn),  G::transition(Holding, G::Hold)},
+    /* Holding */ {G::transition(Holding), G::transition(ClickIdle),                G::transition(Turning, G::PressAndTurn),   G::transition(Holding)},
+    /* Turning */ {G::transition(Turning), G::transition(ClickIdle),                G::transition(Turning),                    G::transition(Turning)},
+};
+constexpr uint16_t CLICK_TIMEOUTS[ClickStates]{
+    0, ENC_HOLDTIME, ENC_CLICKGAPTIME, ENC_HOLDTIME, ENC_CLICKGAPTIME, ENC_HOLDTIME, 0, 0};
+
+// ButtonChord: number of pressed buttons changed to
+enum eChordEvents : uint8_t
+{
+    NonePressed = 0,
+    OnePressed,
+    BothPressed
+};
+enum eChordStates : uint8_t
+{
+    ChordIdle = 0,
+    Waiting,
+    Chorded,
+    Single,
+    ChordStates
+};
+constexpr uint8_t CHORD_TRANSITIONS[ChordStates][G::EVENTS]{
+    //            NonePressed                OnePressed                  BothPressed                          Timeout
+    /* Idle    */ {G::transition(ChordIdle), G::transition(Waiting),     G::transition(Chorded, G::Chord),    G::transition(ChordIdle)},
+    /* Waiting */ {G::transition(ChordIdle), G::transition(Waiting),     G::transition(Chorded, G::Chord),    G::transition(Single)},
+    /* Chorded */ {G::transition(ChordIdle), G::transition(Chorded),     G::transition(Chorded),              G::transition(Chorded)},
+    /* Single  */ {G::transition(ChordIdle), G::transition(Single),      G::transition(Single),               G::transition(Single)},
+};
+constexpr uint16_t CHORD_TIMEOUTS[ChordStates]{0, ENC_CHORDTIME, 0, 0};
+} // namespace
+
 /// ClickEncoders typically have 5 pins: A, B, C (enc GND), BTN, GND
 ClickEncoder::ClickEncoder(
     uint8_t A,
@@ -41,6 +223,7 @@ ClickEncoder::ClickEncoder(
     uint8_t BTN,
     uint8_t stepsPerNotch,
     bool active)
+    : gestures(CLICK_TRANSITIONS, CLICK_TIMEOUTS)
 {
     enc = new Encoder(A, B, stepsPerNotch, active);
     btn = new Button(BTN, active);
@@ -60,58 +243,223 @@ void ClickEncoder::service(void)
 {
     enc->service();
     btn->service();
+    if (gesturesEnabled)
+    {
+        handleGestures();
+    }
+}
+
+void ClickEncoder::handleGestures()
+{
+    gestures.tick();
+    bool pressed = btn->isPressed();
+    if (pressed != lastGesturePressed)
+    {
+        lastGesturePressed = pressed;
+        lastGestureAccumulate = enc->getAccumulate();
+        gestures.handle(pressed ? Press : Release);
+        return;
+    }
+    if (!pressed)
+    {
+        return;
+    }
+
+    // turns only make a gesture while pressed
+    int32_t accumulate = enc->getAccumulate();
+    if (accumulate != lastGestureAccumulate)
+    {
+        lastGestureAccumulate = accumulate;
+        gestures.handle(Turn);
+    }
+}
+
+ButtonChord::ButtonChord(Button &first, Button &second)
+    : first(first), second(second), engine(CHORD_TRANSITIONS, CHORD_TIMEOUTS)
+{
+}
+
+void ButtonChord::service()
+{
+    engine.tick();
+    uint8_t pressedCount = first.isPressed() + second.isPressed();
+    if (pressedCount == lastPressedCount)
+    {
+        return;
+    }
+    lastPressedCount = pressedCount;
+    engine.handle(pressedCount);
 }
 
 // call this every 1 millisecond via timer ISR
 void Encoder::service()
 {
-    handleEncoder();
+    if (pinA == ENC_NOPIN)
+    {
+        // sampled elsewhere, only ::service(levelA, levelB) applies
+        return;
+    }
+    bool levelA = digitalRead(pinA);
+    bool levelB = digitalRead(pinB);
+    service(levelA, levelB);
+}
+
+// call this every 1 millisecond via timer ISR, with pin levels sampled elsewhere
+void Encoder::service(bool levelA, bool levelB)
+{
+    if (trace)
+    {
+        trace->record(traceChannel, levelA | (levelB << 1));
+    }
+    handleElapsedTick();
+    handleEncoder(getBitCode(levelA, levelB));
+}
+
+// call this on every pin change in between ::service() calls, e.g. from edge events
+void Encoder::update(bool levelA, bool levelB)
+{
+    if (trace)
+    {
+        trace->record(traceChannel, levelA | (levelB << 1));
+    }
+    handleEncoder(getBitCode(levelA, levelB));
+}
+
+void Encoder::prime(bool levelA, bool levelB)
+{
+    filterA.reset(levelA);
+    filterB.reset(levelB);
+    lastEncoderRead = getBitCode(levelA, levelB);
 }
 
 // call this every 1 millisecond via timer ISR
 void Button::service()
 {
+    if (pinBTN == ENC_NOPIN)
+    {
+        // no button (e.g. ClickEncoder without one) or sampled elsewhere
+        return;
+    }
     ++lastGetButtonCount;
-    handleButton();
+    if (filterBTN.isEnabled())
+    {
+        // oversample: filter needs every sample, not only the debounced ones
+        filterBTN.filter(readPin());
+    }
+
+    if (lastGetButtonCount >= ENC_BUTTONINTERVAL)
+    {
+        handleButton(readButton());
+    }
+}
+
+// call this every 1 millisecond via timer ISR, with pin level sampled elsewhere
+void Button::service(bool level)
+{
+    ++lastGetButtonCount;
+    if (trace)
+    {
+        trace->record(traceChannel, level);
+    }
+    level = filterBTN.filter(level);
+
+    if (lastGetButtonCount >= ENC_BUTTONINTERVAL)
+    {
+        handleButton(level);
+    }
 }
 
 // ----------------------------------------------------------------------------
 
-void Encoder::handleEncoder()
+void Encoder::handleElapsedTick()
+{
+    // time base of skipped-state recovery and acceleration
+    if (lastDirectionAge < ENC_SKIPRECOVERY_TIMEOUT)
+    {
+        ++lastDirectionAge;
+    }
+    if (lastMovedCount < ENC_ACCEL_START)
+    {
+        ++lastMovedCount;
+    }
+}
+
+void Encoder::handleEncoder(uint8_t encoderRead)
 {
-    uint8_t encoderRead = getBitCode();
     // bit0 set = status changed, bit1 set = "overflow 3" where it goes 0->3 or 3->0
     uint8_t rawMovement = encoderRead - lastEncoderRead;
     lastEncoderRead = encoderRead;
     // This is the uint->int magic, converts raw to: -1 counterclockwise, 0 no turn, 1 clockwise
     int8_t signedMovement = ((rawMovement & 1) - (rawMovement & 2));
+    signedMovement = handleSkippedState(rawMovement, signedMovement);
+
+    // add unsigned: wraps around instead of overflowing
+    int32_t lastAccumulate = encoderAccumulate;
+    encoderAccumulate = static_cast<int32_t>(static_cast<uint32_t>(lastAccumulate) + static_cast<uint32_t>(signedMovement));
+    int8_t acceleration = handleAcceleration(signedMovement);
+    encoderAccumulate = static_cast<int32_t>(static_cast<uint32_t>(encoderAccumulate) + static_cast<uint32_t>(acceleration));
+    handleActivity(lastAccumulate);
+}
 
-    encoderAccumulate += signedMovement;
-    encoderAccumulate += handleAcceleration(signedMovement);
+void Encoder::handleActivity(int32_t lastAccumulate)
+{
+    if (lastAccumulate != encoderAccumulate)
+    {
+        // at most a few notches per call: the truncated unsigned difference stays defined across the wrap
+        int16_t notches = static_cast<int16_t>(static_cast<uint32_t>(encoderAccumulate / stepsPerNotch) -
+                                               static_cast<uint32_t>(lastAccumulate / stepsPerNotch));
+        if (notches)
+        {
+            handleBoundValue(notches);
+            InputActivity::notify();
+        }
+    }
+    // acceleration and skipped-state recovery depend on time since last move
+    InputActivity::setBusy(busy, (lastDirectionAge < ENC_SKIPRECOVERY_TIMEOUT) ||
+                                     (accelerationEnabled && (lastMovedCount < ENC_ACCEL_START)));
 }
 
-uint8_t Encoder::getBitCode()
+uint8_t Encoder::getBitCode(bool levelA, bool levelB)
 {
     // GrayCode convert
     // !A && !B --> 0
     // !A &&  B --> 1
     //  A &&  B --> 2
     //  A && !B --> 3
-    uint8_t currentEncoderRead = digitalRead(pinA);
+    uint8_t currentEncoderRead = filterA.filter(levelA);
     currentEncoderRead |= (currentEncoderRead << 1);
     
     // invert result's 0th bit if set
-    currentEncoderRead ^= digitalRead(pinB);
+    currentEncoderRead ^= filterB.filter(levelB);
     return currentEncoderRead;
 }
 
-int8_t Encoder::handleAcceleration(int8_t direction)
+int8_t Encoder::handleSkippedState(uint8_t rawMovement, int8_t signedMovement)
 {
-    if (lastMovedCount < ENC_ACCEL_START)
+    if ((rawMovement & 3) != 2)
     {
-        ++lastMovedCount;
+        // valid single step (or no move): remember its direction
+        if (signedMovement != 0)
+        {
+            lastDirection = signedMovement;
+            lastDirectionAge = 0;
+        }
+        return signedMovement;
+    }
+
+    // skipped state: direction cannot be read from the code itself.
+    // Assume the encoder kept on turning the way it recently did.
+    if (!skipRecoveryEnabled || (lastDirectionAge >= ENC_SKIPRECOVERY_TIMEOUT))
+    {
+        return signedMovement;
     }
+    ++inferredSteps;
+    lastDirectionAge = 0;
+    return (lastDirection > 0) ? 2 : -2;
+}
 
+int8_t Encoder::handleAcceleration(int8_t direction)
+{
     if (direction == 0 || !accelerationEnabled || (encoderAccumulate % stepsPerNotch))
     {
         return 0;
@@ -131,75 +479,241 @@ int8_t Encoder::handleAcceleration(int8_t direction)
 }
 // ----------------------------------------------------------------------------
 
-// returns number of notches that the encoder was turned since the last poll
+EncoderCursor::EncoderCursor(Encoder &encoder) : encoder(encoder),
+                                                 lastAccumulate(encoder.getAccumulate())
+{
+}
+
+// returns number of notches that the encoder was turned since this cursor's last poll
 // takes acceleration into account if configured
-int16_t Encoder::getIncrement()
+int16_t EncoderCursor::getIncrement()
 {
-    int16_t accu = getAccumulate();
-    int16_t encoderIncrements = accu - lastEncoderAccumulate;
-    lastEncoderAccumulate = accu;
+    int32_t accu = encoder.getAccumulate();
+    // unsigned difference stays correct across an overflow
+    int16_t encoderIncrements = static_cast<int16_t>(static_cast<uint32_t>(accu) - static_cast<uint32_t>(lastAccumulate));
+    lastAccumulate = accu;
     return (encoderIncrements);
 }
 
 // returns sum of notches that the encoder was turned since startup
 // takes acceleration into account if configured
-int16_t Encoder::getAccumulate()
+int32_t Encoder::getAccumulate()
 {
-    return (encoderAccumulate / stepsPerNotch);
+    return (readAccumulate() / stepsPerNotch);
 }
 
-// ----------------------------------------------------------------------------
-void Button::handleButton()
+// returns notches (Q8.8) that the encoder was turned since the last poll,
+// including steps in between notches
+int32_t Encoder::getFractionalIncrement()
+{
+    int32_t accu = readAccumulate();
+    // difference of positions: remainders of the division don't get lost between polls
+    uint32_t position = static_cast<uint32_t>(stepsToFixedPoint(accu));
+    uint32_t lastPosition = static_cast<uint32_t>(stepsToFixedPoint(lastFractionalAccumulate));
+    lastFractionalAccumulate = accu;
+    return static_cast<int32_t>(position - lastPosition);
+}
+
+// returns sum of notches (Q8.8) that the encoder was turned since startup,
+// including steps in between notches
+int32_t Encoder::getPosition()
 {
-    if (lastGetButtonCount < ENC_BUTTONINTERVAL)
+    return stepsToFixedPoint(readAccumulate());
+}
+
+int32_t Encoder::stepsToFixedPoint(int32_t steps)
+{
+    if (fixedPointShift)
+    {
+        // shift unsigned to stay well-defined for negative steps
+        return static_cast<int32_t>(static_cast<uint32_t>(steps) << fixedPointShift);
+    }
+    // split into notches and remainder: steps * 256 would overflow beyond 2^23 steps
+    int32_t notches = steps / stepsPerNotch;
+    int32_t remainder = steps % stepsPerNotch;
+    return static_cast<int32_t>(static_cast<uint32_t>(notches) * 256 + static_cast<uint32_t>((remainder * 256) / stepsPerNotch));
+}
+
+// 32 bit reads take several instructions on 8 bit MCUs: read until ::service() didn't interfere
+int32_t Encoder::readAccumulate()
+{
+    int32_t accu;
+    do
     {
+        accu = encoderAccumulate;
+    } while (accu != encoderAccumulate);
+    return accu;
+}
+
+void Encoder::bindValue(volatile int16_t *value, int16_t min, int16_t max, int16_t step, bool wrap)
+{
+    if (max < min)
+    {
+        int16_t swap = min;
+        min = max;
+        max = swap;
+    }
+    // ::service() must not see a half configured binding
+    ServiceLock lock;
+    boundMin = min;
+    boundMax = max;
+    boundStep = step;
+    boundWrap = wrap;
+    if (value)
+    {
+        // start within range
+        *value = (*value < min) ? min : ((*value > max) ? max : *value);
+    }
+    boundValue = value;
+}
+
+void Encoder::handleBoundValue(int32_t notches)
+{
+    if (!boundValue)
+    {
+        return;
+    }
+
+    int32_t value = *boundValue + notches * boundStep;
+    if ((value >= boundMin) && (value <= boundMax))
+    {
+        *boundValue = value;
         return;
     }
+
+    if (boundWrap)
+    {
+        int32_t range = static_cast<int32_t>(boundMax) - boundMin + 1;
+        value = (value - boundMin) % range;
+        *boundValue = boundMin + ((value < 0) ? value + range : value);
+    }
+    else
+    {
+        *boundValue = (value < boundMin) ? boundMin : boundMax;
+    }
+}
+
+// ----------------------------------------------------------------------------
+void Button::handleButton(bool level)
+{
     lastGetButtonCount = 0;
 
-    if (digitalRead(pinBTN) == pinActiveState)
+    if (key.handle(level == pinActiveState, doubleClickEnabled, longPressRepeatEnabled, repeatRamp))
+    {
+        InputActivity::notify();
+    }
+    InputActivity::setBusy(busy, key.isBusy());
+}
+
+bool Button::readButton()
+{
+    if (filterBTN.isEnabled())
+    {
+        return filterBTN.getState();
+    }
+    return readPin();
+}
+
+bool Button::readPin()
+{
+    bool level = digitalRead(pinBTN);
+    if (trace)
+    {
+        trace->record(traceChannel, level);
+    }
+    return level;
+}
+
+// ----------------------------------------------------------------------------
+
+void Button::RepeatRamp::configure(uint16_t startInterval, uint16_t minInterval, uint8_t rampSteps)
+{
+    // ticks have to fit into 8 bits
+    constexpr uint16_t MAX_INTERVAL = UINT8_MAX * ENC_BUTTONINTERVAL;
+    if (startInterval > MAX_INTERVAL)
+    {
+        startInterval = MAX_INTERVAL;
+    }
+    if (minInterval > startInterval)
+    {
+        minInterval = startInterval;
+    }
+    startTicks = startInterval / ENC_BUTTONINTERVAL;
+    minTicks = minInterval / ENC_BUTTONINTERVAL;
+    stepTicks = (startTicks - minTicks) / (rampSteps ? rampSteps : 1);
+    // more steps than ticks to shrink: still ramp down, one tick per repeat
+    if ((stepTicks == 0) && (startTicks > minTicks))
+    {
+        stepTicks = 1;
+    }
+}
+
+bool Button::Key::handle(bool pressed, bool doubleClickEnabled, bool longPressRepeatEnabled, const RepeatRamp &ramp)
+{
+    eButtonStates lastButtonState = buttonState;
+    if (pressed)
     {
-        handleButtonPressed();
+        handleButtonPressed(longPressRepeatEnabled, ramp);
     }
     else
     {
-        handleButtonReleased();
+        handleButtonReleased(doubleClickEnabled);
     }
 
     if (doubleClickTicks > 0)
     {
         --doubleClickTicks;
     }
+
+    return (buttonState != lastButtonState);
 }
 
-void Button::handleButtonPressed()
+void Button::Key::handleButtonPressed(bool longPressRepeatEnabled, const RepeatRamp &ramp)
 {
-    buttonState = Closed;
-    ++keyDownTicks;
-    if (keyDownTicks >= (ENC_HOLDTIME / ENC_BUTTONINTERVAL))
+    if (keyDownTicks < (ENC_HOLDTIME / ENC_BUTTONINTERVAL))
     {
-        buttonState = Held;
-        if (!longPressRepeatEnabled)
+        buttonState = Closed;
+        ++keyDownTicks;
+        if (keyDownTicks < (ENC_HOLDTIME / ENC_BUTTONINTERVAL))
         {
             return;
         }
+        // just became held: report Held once, first repeat one interval from now
+        buttonState = Held;
+        repeatTicks = 0;
+        repeatInterval = ramp.startTicks;
+        return;
+    }
+
+    if (!longPressRepeatEnabled)
+    {
+        return;
+    }
 
-        // Blip out LongPressRepeat once per interval
-        if (keyDownTicks > ((ENC_LONGPRESSREPEATINTERVAL + ENC_HOLDTIME) / ENC_BUTTONINTERVAL))
+    // only a new repeat changes the state while held
+    if (++repeatTicks >= repeatInterval)
+    {
+        repeatTicks = 0;
+        if (repeatCount < UINT8_MAX)
         {
-            buttonState = LongPressRepeat;
+            ++repeatCount;
         }
+        // ramp down, subtraction only
+        repeatInterval = (repeatInterval > (ramp.minTicks + ramp.stepTicks)) ? repeatInterval - ramp.stepTicks : ramp.minTicks;
+        buttonState = LongPressRepeat;
     }
 }
 
-void Button::handleButtonReleased()
+void Button::Key::handleButtonReleased(bool doubleClickEnabled)
 {
+    uint16_t downTicks = keyDownTicks;
     keyDownTicks = 0;
-    if (buttonState == Held)
+    // Released after every hold, also if Held or LongPressRepeat were read already
+    if (downTicks >= (ENC_HOLDTIME / ENC_BUTTONINTERVAL))
     {
         buttonState = Released;
     }
-    else if (buttonState == Closed)
+    else if (downTicks > 0)
     {
         buttonState = Clicked;
         if (!doubleClickEnabled)
@@ -221,13 +735,16 @@ void Button::handleButtonReleased()
     }
 }
 
-Button::eButtonStates Button::getButton(void)
+Button::eButtonStates Button::Key::getButton(void)
 {
-    volatile Button::eButtonStates result{buttonState};
+    // ::service() must not count a repeat or change the state in between read and reset
+    ServiceLock lock;
+    Button::eButtonStates result{buttonState};
     if (result == LongPressRepeat)
     {
-        // Reset to "Held"
-        keyDownTicks = (ENC_HOLDTIME / ENC_BUTTONINTERVAL);
+        // hand all repeats since the last read to the caller
+        lastRepeatCount = repeatCount;
+        repeatCount = 0;
     }
 
     // reset after readout. Conditional to neither miss nor repeat DoubleClicks or Helds
@@ -237,4 +754,48 @@ Button::eButtonStates Button::getButton(void)
     }
 
     return result;
-}
\ No newline at end of file
+}
+
+// ----------------------------------------------------------------------------
+
+GestureEngine::GestureEngine(const uint8_t (*transitions)[EVENTS], const uint16_t *timeouts)
+    : transitions(transitions), timeouts(timeouts)
+{
+}
+
+void GestureEngine::handle(uint8_t event)
+{
+    uint8_t entry = transitions[state][event];
+    uint8_t nextState = entry & 0x0F;
+    if (entry >> 4)
+    {
+        gesture = static_cast<eGestures>(entry >> 4);
+    }
+    if (nextState != state)
+    {
+        state = nextState;
+        stateTicks = 0;
+    }
+}
+
+void GestureEngine::tick()
+{
+    if (timeouts[state] == 0)
+    {
+        return;
+    }
+    ++stateTicks;
+    if (stateTicks >= timeouts[state])
+    {
+        handle(TIMEOUT);
+    }
+}
+
+GestureEngine::eGestures GestureEngine::getGesture()
+{
+    // ::service() must not report a gesture in between read and reset
+    ServiceLock lock;
+    eGestures result{gesture};
+    gesture = NoGesture;
+    return result;
+}
@@ -10,8 +10,10 @@
 
 #ifdef UNIT_TEST
     #include "ArduinoFake.h"
-#else
+#elif defined(ARDUINO)
     #include "Arduino.h"
+#else
+    #include "ClickEncoderHost.h"
 #endif
 
 // ----------------------------------------------------------------------------
@@ -20,42 +22,278 @@
 constexpr uint8_t ENC_ACCEL_START = 150; // The smaller this value, the quicker you must turn to activate acceleration.
 constexpr uint8_t ENC_ACCEL_SLOPE = 75; // the smaller this value, the stronger the acceleration will manipulate values.
 
+// Skipped-state recovery configuration
+//
+constexpr uint8_t ENC_SKIPRECOVERY_TIMEOUT = 100; // direction of last valid step is trusted for x service calls
+
 // Button configuration (values for 1ms timer service calls)
 //
 constexpr uint8_t ENC_BUTTONINTERVAL = 20;            // check button every x ms, also debouce time
 constexpr uint16_t ENC_DOUBLECLICKTIME = 400;         // second click within x ms
 constexpr uint16_t ENC_LONGPRESSREPEATINTERVAL = 200; // reports repeating-held every x ms
+constexpr uint16_t ENC_LONGPRESSREPEATMININTERVAL = 200; // repeat interval ramps down to x ms. Same as above: no ramp
+constexpr uint8_t ENC_LONGPRESSREPEATRAMPSTEPS = 1;      // reach minimum interval after x repeats
 constexpr uint16_t ENC_HOLDTIME = 1200;               // report held button after x ms
+
+// Gesture configuration (values for 1ms timer service calls)
+//
+constexpr uint16_t ENC_CLICKGAPTIME = ENC_DOUBLECLICKTIME; // next click of a multi-click within x ms
+constexpr uint8_t ENC_CHORDTIME = 60;                      // second button of a chord pressed within x ms
+
+// Pin configuration
+//
+constexpr uint8_t ENC_NOPIN = 0xFF; // not connected: neither configured nor read
+
+// Trace configuration
+//
+constexpr uint8_t TRACE_MAX_CHANNELS = 16; // channels of a TraceRecorder, 4 bits in its header
 // ----------------------------------------------------------------------------
 
+// Selects the constructors of instances without own pins, e.g. sampled by an
+// InputSource and fed via ::service(levels) only.
+struct SampledElsewhere
+{
+};
+constexpr SampledElsewhere SAMPLED_ELSEWHERE{};
+
+// Keeps ::service() out while the main loop hands over state shared with it.
+// Restores the previous interrupt state, so it can be taken within ISRs too.
+// No-op on hosts, where ::service() doesn't interrupt the caller.
+class ServiceLock
+{
+public:
+#if defined(__AVR__) && !defined(UNIT_TEST)
+    ServiceLock() : sreg(SREG) { cli(); };
+    ~ServiceLock() { SREG = sreg; };
+
+private:
+    const uint8_t sreg;
+#elif defined(ARDUINO) && defined(__ARM_ARCH_PROFILE) && (__ARM_ARCH_PROFILE == 'M') && !defined(UNIT_TEST)
+    // Cortex-M: PRIMASK, without relying on the core shipping CMSIS
+    ServiceLock() : primask(readPrimask()) { __asm__ volatile("cpsid i" ::: "memory"); };
+    ~ServiceLock() { __asm__ volatile("msr primask, %0" ::"r"(primask) : "memory"); };
+
+private:
+    static uint32_t readPrimask()
+    {
+        uint32_t value;
+        __asm__ volatile("mrs %0, primask" : "=r"(value));
+        return value;
+    };
+    const uint32_t primask;
+#elif defined(ESP8266) && !defined(UNIT_TEST)
+    ServiceLock() : ps(xt_rsil(15)){};
+    ~ServiceLock() { xt_wsr_ps(ps); };
+
+private:
+    const uint32_t ps;
+#elif defined(ESP32) && !defined(UNIT_TEST)
+    // within an ISR the others are held off already: don't enable interrupts when leaving
+    ServiceLock() : inIsr(xPortInIsrContext())
+    {
+        if (!inIsr)
+        {
+            noInterrupts();
+        }
+    };
+    ~ServiceLock()
+    {
+        if (!inIsr)
+        {
+            interrupts();
+        }
+    };
+
+private:
+    const bool inIsr;
+#elif defined(ARDUINO) && !defined(UNIT_TEST)
+    // Other cores: the interrupt state can't be read, so don't call getters from an ISR
+    ServiceLock() { noInterrupts(); };
+    ~ServiceLock() { interrupts(); };
+#else
+    ServiceLock(){};
+#endif
+};
+
+// Optional K-of-N filter for a single input line, e.g. for noisy long cables.
+// Keeps the last N raw samples packed into a byte and only passes a change
+// once at least K of them agree. N = 1, K = 1 passes samples through.
+class InputFilter
+{
+public:
+    InputFilter() = default;
+
+    // depth: number of samples kept (1..8), threshold: samples needed to agree (1..depth)
+    // level: current state of the line to start with
+    void configure(uint8_t depth, uint8_t threshold, bool level);
+    // keeps depth and threshold, starts over at level
+    void reset(bool level);
+    bool filter(bool sample);
+    bool getState() const { return state; };
+    bool isEnabled() const { return sampleMask != 1; };
+
+private:
+    static uint8_t countOnes(uint8_t samples);
+
+    uint8_t sampleMask{1};
+    uint8_t threshold{1};
+    uint8_t samples{0};
+    bool state{false};
+};
+
+class TraceRecorder;
+template <uint8_t Rows, uint8_t Cols>
+class ButtonMatrix;
+template <uint8_t Tracks>
+class AbsoluteEncoder;
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+class Panel;
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+class FrameCoalescer;
+class InputEvents;
+
+// Aggregate activity of all Encoder and Button instances.
+// Lets the main loop sleep until the next interrupt if nothing happened,
+// and lets the application stop the ::service() timer while all are idle.
+class InputActivity
+{
+public:
+    // true if any instance reported a change since the last acknowledge()
+    static bool isPending() { return pending; };
+    // call before reading the instances, so changes during the read stay pending
+    static void acknowledge() { pending = false; };
+    // incremented by every reported change, compare to detect news without acknowledging
+    static uint8_t getSequence() { return sequence; };
+    // true if no button is pressed, no timeout is running and no encoder recently moved
+    static bool isIdle() { return busyCount == 0; };
+    // Called from ::service() when the last busy instance became idle.
+    // From then on, ::service() calls can be stopped until the next pin change.
+    static void setIdleCallback(void (*callback)()) { idleCallback = callback; };
+
+private:
+    friend class Encoder;
+    friend class Button;
+    template <uint8_t Rows, uint8_t Cols>
+    friend class ButtonMatrix;
+    template <uint8_t Tracks>
+    friend class AbsoluteEncoder;
+    static void notify();
+    static void setBusy(volatile bool &instanceBusy, bool isBusy);
+
+    static volatile bool pending;
+    static volatile uint8_t sequence;
+    static volatile uint8_t busyCount;
+    static void (*idleCallback)();
+};
+
+class Encoder;
+
+// Independent reader of an Encoder's notches. Every cursor keeps its own
+// snapshot, so several tasks can each ask for movement since they last looked.
+// Reading needs no lock: ::service() only ever writes the shared accumulator.
+class EncoderCursor
+{
+public:
+    // starts at the encoder's current position
+    explicit EncoderCursor(Encoder &encoder);
+
+    // returns notch changes since last call of this cursor
+    int16_t getIncrement();
+
+private:
+    Encoder &encoder;
+    int32_t lastAccumulate;
+};
+
 class Encoder
 {
 public:
     explicit Encoder(uint8_t A, uint8_t B, uint8_t stepsPerNotch = 4, bool active = LOW);
-    ~Encoder() = default;
+    explicit Encoder(SampledElsewhere, uint8_t stepsPerNotch = 4, bool active = LOW);
+    ~Encoder();
     Encoder(const Encoder &cpyEncoder) = delete;
     Encoder &operator=(const Encoder &srcEncoder) = delete;
 
     void service();
-    int16_t getIncrement();
-    int16_t getAccumulate();
+    // for pins sampled elsewhere, e.g. port expanders or edge events
+    void service(bool levelA, bool levelB);
+    void update(bool levelA, bool levelB);
+    // Takes the levels as resting position without counting a step.
+    // For lines sampled elsewhere, before the first ::service() or update().
+    void prime(bool levelA, bool levelB);
+    // default cursor, use EncoderCursor for additional readers
+    int16_t getIncrement() { return cursor.getIncrement(); };
+    int32_t getAccumulate();
+    // Same as above, but with full step resolution: fixed point Q8.8, 256 equals one notch
+    int32_t getFractionalIncrement();
+    int32_t getPosition();
+    // Moves *value by step per notch within ::service(), kept within min..max (swapped if max < min).
+    // wrap: continue at the other end instead of stopping at the limit. nullptr unbinds.
+    void bindValue(volatile int16_t *value, int16_t min, int16_t max, int16_t step = 1, bool wrap = false);
     void setAccelerationEnabled(const bool a) { accelerationEnabled = a; };
+    // If active, skipped states (2-step jumps) are counted in the direction of recent valid motion.
+    void setSkipRecoveryEnabled(const bool s) { skipRecoveryEnabled = s; };
+    // returns number of 2-step jumps that have been resolved by skipped-state recovery
+    uint16_t getInferredSteps() { return inferredSteps; };
+    // Filters both encoder lines. Change only passes when threshold of depth samples agree.
+    void setInputFilter(uint8_t depth, uint8_t threshold);
+    // Records raw level transitions (bit0 A, bit1 B) as given channel. nullptr stops.
+    // Returns false if channel is not below TRACE_MAX_CHANNELS.
+    bool setTraceRecorder(TraceRecorder *recorder, uint8_t channel)
+    {
+        if (channel >= TRACE_MAX_CHANNELS)
+        {
+            return false;
+        }
+        traceChannel = channel;
+        trace = recorder;
+        return true;
+    };
 
 private:
-    uint8_t getBitCode();
-    void handleEncoder();
+    template <uint8_t MaxEncoders, uint8_t MaxButtons>
+    friend class Panel;
+    template <uint8_t MaxEncoders, uint8_t MaxButtons>
+    friend class FrameCoalescer;
+
+    uint8_t getBitCode(bool levelA, bool levelB);
+    int8_t handleSkippedState(uint8_t rawMovement, int8_t signedMovement);
+    void handleElapsedTick();
+    void handleEncoder(uint8_t encoderRead);
     int8_t handleAcceleration(int8_t direction);
+    void handleActivity(int32_t lastAccumulate);
+    void handleBoundValue(int32_t notches);
+    int32_t readAccumulate();
+    int32_t stepsToFixedPoint(int32_t steps);
 
     const uint8_t pinA;
     const uint8_t pinB;
     const uint8_t stepsPerNotch;
     const bool pinActiveState;
+    uint8_t fixedPointShift{0};
 
+    InputFilter filterA;
+    InputFilter filterB;
     bool accelerationEnabled{false};
+    bool skipRecoveryEnabled{false};
     volatile uint8_t lastEncoderRead{0};
-    volatile int16_t encoderAccumulate{0};
-    volatile int16_t lastEncoderAccumulate{0};
+    // steps, wraps around after 2^31 steps in one direction
+    volatile int32_t encoderAccumulate{0};
+    EncoderCursor cursor{*this};
+    int32_t lastFractionalAccumulate{0};
+    // pointer itself is volatile: bindValue() changes it while ::service() may run
+    volatile int16_t *volatile boundValue{nullptr};
+    int16_t boundMin{0};
+    int16_t boundMax{0};
+    int16_t boundStep{1};
+    bool boundWrap{false};
     volatile uint8_t lastMovedCount{ENC_ACCEL_START};
+    volatile int8_t lastDirection{0};
+    volatile uint8_t lastDirectionAge{ENC_SKIPRECOVERY_TIMEOUT};
+    volatile uint16_t inferredSteps{0};
+    TraceRecorder *trace{nullptr};
+    uint8_t traceChannel{0};
+    volatile bool busy{false};
 };
 
 class Button
@@ -72,37 +310,173 @@ public:
         DoubleClicked
     };
 
+    // LongPressRepeat interval ramp, in ENC_BUTTONINTERVAL ticks.
+    // Interval shrinks by stepTicks per repeat, so the ISR needs no division.
+    struct RepeatRamp
+    {
+        // intervals in ms up to 255 * ENC_BUTTONINTERVAL, minInterval reached after rampSteps repeats
+        void configure(uint16_t startInterval, uint16_t minInterval, uint8_t rampSteps);
+
+        uint8_t startTicks{ENC_LONGPRESSREPEATINTERVAL / ENC_BUTTONINTERVAL};
+        uint8_t minTicks{ENC_LONGPRESSREPEATMININTERVAL / ENC_BUTTONINTERVAL};
+        uint8_t stepTicks{((ENC_LONGPRESSREPEATINTERVAL - ENC_LONGPRESSREPEATMININTERVAL) / ENC_BUTTONINTERVAL) /
+                          ENC_LONGPRESSREPEATRAMPSTEPS};
+    };
+
+    // Click, DoubleClick, Held and LongPressRepeat detection of one debounced key.
+    // Advanced once per ENC_BUTTONINTERVAL, shared with ButtonMatrix.
+    class Key
+    {
+    public:
+        // returns true if the state to report changed
+        bool handle(bool pressed, bool doubleClickEnabled, bool longPressRepeatEnabled, const RepeatRamp &ramp);
+        eButtonStates getButton();
+        // repeats collected by the last getButton() that returned LongPressRepeat
+        uint8_t getLongPressRepeatCount() const { return lastRepeatCount; };
+        // pressed or waiting for a second click
+        bool isBusy() const { return (keyDownTicks > 0) || (doubleClickTicks > 0); };
+        bool isPressed() const { return keyDownTicks > 0; };
+
+    private:
+        void handleButtonPressed(bool longPressRepeatEnabled, const RepeatRamp &ramp);
+        void handleButtonReleased(bool doubleClickEnabled);
+
+        volatile eButtonStates buttonState{Open};
+        uint8_t doubleClickTicks{0};
+        uint16_t keyDownTicks{0};
+        uint8_t repeatTicks{0};
+        uint8_t repeatInterval{0};
+        volatile uint8_t repeatCount{0};
+        uint8_t lastRepeatCount{0};
+    };
+
     explicit Button(uint8_t BTN, bool active = LOW);
-    ~Button() = default;
+    explicit Button(SampledElsewhere, bool active = LOW);
+    ~Button();
     Button(const Button &cpyButton) = delete;
     Button &operator=(const Button &srcButton) = delete;
 
     void service();
-    eButtonStates getButton();
+    // for pins sampled elsewhere, e.g. port expanders or edge events
+    void service(bool level);
+    eButtonStates getButton() { return key.getButton(); };
+    // debounced level, does not consume any state
+    bool isPressed() const { return key.isPressed(); };
     void setDoubleClickEnabled(const bool b) { doubleClickEnabled = b; };
-    // LongPressRepeat will overlay "Held" state. Thus, "Held" shouldn't be user in user code then!
+    // Held is reported once per press, LongPressRepeat for every repeat after it
     void setLongPressRepeatEnabled(const bool b) { longPressRepeatEnabled = b; };
+    // Repeat interval shrinks from startInterval to minInterval (ms) over rampSteps repeats
+    void setLongPressRepeatRamp(uint16_t startInterval, uint16_t minInterval, uint8_t rampSteps)
+    {
+        repeatRamp.configure(startInterval, minInterval, rampSteps);
+    };
+    // Repeats since the previous LongPressRepeat was read, valid after getButton() returned it.
+    // A slow main loop applies them all at once instead of missing some.
+    uint8_t getLongPressRepeatCount() const { return key.getLongPressRepeatCount(); };
+    // Samples button every service call. Change only passes when threshold of depth samples agree.
+    void setInputFilter(uint8_t depth, uint8_t threshold);
+    // Records raw level transitions as given channel. nullptr stops.
+    // Returns false if channel is not below TRACE_MAX_CHANNELS.
+    bool setTraceRecorder(TraceRecorder *recorder, uint8_t channel)
+    {
+        if (channel >= TRACE_MAX_CHANNELS)
+        {
+            return false;
+        }
+        traceChannel = channel;
+        trace = recorder;
+        return true;
+    };
 
 private:
-    void handleButton();
-    void handleButtonPressed();
-    void handleButtonReleased();
+    bool readButton();
+    bool readPin();
+    void handleButton(bool level);
 
     const uint8_t pinBTN;
     const bool pinActiveState;
 
+    InputFilter filterBTN;
     bool doubleClickEnabled{false};
     bool longPressRepeatEnabled{false};
-    volatile eButtonStates buttonState{Open};
-    uint8_t doubleClickTicks{0};
-    uint16_t keyDownTicks{0};
+    RepeatRamp repeatRamp;
+    Key key;
     uint16_t lastGetButtonCount{ENC_BUTTONINTERVAL};
+    TraceRecorder *trace{nullptr};
+    uint8_t traceChannel{0};
+    volatile bool busy{false};
+};
+
+// Transition table driven gesture detection.
+// Each table row is a state, each column an input event. The last column is
+// taken when the state's timeout elapsed. An entry packs the next state
+// (low nibble) and the gesture to report on that transition (high nibble).
+// Decision latency, counted from the debounced input completing a gesture:
+// TripleClick, PressAndTurn, Chord: same ::service() call
+// Click, DoubleClick: ENC_CLICKGAPTIME after the last release
+// Hold: ENC_HOLDTIME after the press
+class GestureEngine
+{
+public:
+    enum eGestures
+    {
+        NoGesture = 0,
+        Click,
+        DoubleClick,
+        TripleClick,
+        Hold,
+        PressAndTurn,
+        Chord
+    };
+
+    static constexpr uint8_t EVENTS = 4;
+    static constexpr uint8_t TIMEOUT = EVENTS - 1;
+    static constexpr uint8_t transition(uint8_t nextState, eGestures gesture = NoGesture)
+    {
+        return static_cast<uint8_t>(nextState | (gesture << 4));
+    }
+
+    // timeouts: ticks until TIMEOUT per state, 0 never times out. State 0 is idle.
+    GestureEngine(const uint8_t (*transitions)[EVENTS], const uint16_t *timeouts);
+
+    void handle(uint8_t event);
+    // call once per ::service() while not idle
+    void tick();
+    bool isIdle() const { return state == 0; };
+    // returns the last detected gesture once
+    eGestures getGesture();
+
+private:
+    const uint8_t (*const transitions)[EVENTS];
+    const uint16_t *const timeouts;
+    uint8_t state{0};
+    uint16_t stateTicks{0};
+    volatile eGestures gesture{NoGesture};
+};
+
+// Reports a Chord gesture if two buttons are pressed within ENC_CHORDTIME.
+// Call ::service() right after both buttons' ::service().
+class ButtonChord
+{
+public:
+    ButtonChord(Button &first, Button &second);
+    ButtonChord(const ButtonChord &cpyChord) = delete;
+    ButtonChord &operator=(const ButtonChord &srcChord) = delete;
+
+    void service();
+    GestureEngine::eGestures getGesture() { return engine.getGesture(); };
+
+private:
+    Button &first;
+    Button &second;
+    GestureEngine engine;
+    uint8_t lastPressedCount{0};
 };
 
 class ClickEncoder
 {
 public:
-    explicit ClickEncoder(uint8_t A, uint8_t B, uint8_t BTN = -1,
+    explicit ClickEncoder(uint8_t A, uint8_t B, uint8_t BTN = ENC_NOPIN,
                  uint8_t stepsPerNotch = 4, bool active = LOW);
     ~ClickEncoder();
     ClickEncoder(const ClickEncoder &cpyEncoder) = delete;
@@ -112,16 +486,60 @@ public:
     // returns notch changes after last poll
     int16_t getIncrement() { return enc->getIncrement(); };
     // returns overall notch count since startup.
-    int16_t getAccumulate() { return enc->getAccumulate(); };
+    int32_t getAccumulate() { return enc->getAccumulate(); };
+    // fixed point Q8.8 variants of the above, 256 equals one notch
+    int32_t getFractionalIncrement() { return enc->getFractionalIncrement(); };
+    int32_t getPosition() { return enc->getPosition(); };
+    void bindValue(volatile int16_t *value, int16_t min, int16_t max, int16_t step = 1, bool wrap = false)
+    {
+        enc->bindValue(value, min, max, step, wrap);
+    };
     Button::eButtonStates getButton() {  return btn->getButton(); };
+    // Click, DoubleClick, TripleClick, Hold and PressAndTurn, see GestureEngine.
+    // While PressAndTurn is active, getIncrement() reports the turn as usual.
+    GestureEngine::eGestures getGesture() { return gestures.getGesture(); };
+    // e.g. to create an EncoderCursor
+    Encoder &getEncoder() { return *enc; };
+    // Runs the gesture table next to the Button state machine, which getButton() still needs.
+    // Costs a few ns per ::service() call on top, nothing while disabled.
+    void setGesturesEnabled(const bool b) { gesturesEnabled = b; };
     // If active, encoder will count overproportionally quickly if turned fast.
     void setAccelerationEnabled(const bool b) { enc->setAccelerationEnabled(b); };
+    // If active, encoder can be serviced at 2..4ms without reversing on skipped states.
+    void setSkipRecoveryEnabled(const bool b) { enc->setSkipRecoveryEnabled(b); };
     void setDoubleClickEnabled(const bool b) { btn->setDoubleClickEnabled(b); };
-    // LongPressRepeat will overlay "Held" state. Thus, "Held" shouldn't be user in user code then!
+    // Held is reported once per press, LongPressRepeat for every repeat after it
     void setLongPressRepeatEnabled(const bool b) { btn->setLongPressRepeatEnabled(b); };
+    void setLongPressRepeatRamp(uint16_t startInterval, uint16_t minInterval, uint8_t rampSteps)
+    {
+        btn->setLongPressRepeatRamp(startInterval, minInterval, rampSteps);
+    };
+    uint8_t getLongPressRepeatCount() const { return btn->getLongPressRepeatCount(); };
+    void setInputFilter(uint8_t depth, uint8_t threshold)
+    {
+        enc->setInputFilter(depth, threshold);
+        btn->setInputFilter(depth, threshold);
+    };
+    // encoder records as firstChannel, button as firstChannel + 1. Returns false if out of channels.
+    bool setTraceRecorder(TraceRecorder *recorder, uint8_t firstChannel = 0)
+    {
+        if (firstChannel + 1 >= TRACE_MAX_CHANNELS)
+        {
+            return false;
+        }
+        return enc->setTraceRecorder(recorder, firstChannel) && btn->setTraceRecorder(recorder, firstChannel + 1);
+    };
 
 private:
+    friend class InputEvents;
+
+    void handleGestures();
+
     Encoder* enc{nullptr};
     Button* btn{nullptr};
+    GestureEngine gestures;
+    bool gesturesEnabled{false};
+    bool lastGesturePressed{false};
+    int32_t lastGestureAccumulate{0};
 };
 #endif // CLICKENCODER_H
\ No newline at end of file
@@ -0,0 +1,169 @@
+// ----------------------------------------------------------------------------
+// Absolute Gray-code encoder for ClickEncoder
+// Reads all tracks of a 2..8 bit Gray-code rotary switch or encoder at once
+// and reports turns like Encoder (getIncrement, getAccumulate).
+// ----------------------------------------------------------------------------
+
+#ifndef CLICKENCODERABSOLUTE_H
+#define CLICKENCODERABSOLUTE_H
+
+#include "ClickEncoder.h"
+
+// Absolute encoder configuration (for 1ms calls to ::service())
+//
+constexpr uint8_t ENC_ABSOLUTE_STABLETIME = 3; // new position must be read x times in a row
+
+// Gray code to binary: XOR of all higher bits
+constexpr uint8_t grayToBinary(uint8_t gray, uint8_t shift = 1)
+{
+    return (shift >= 8) ? gray : grayToBinary(static_cast<uint8_t>(gray ^ (gray >> shift)), shift << 1);
+}
+
+// compile-time list 0..N-1 to generate lookup tables from
+template <uint16_t... Codes>
+struct GrayCodeSequence
+{
+};
+
+template <uint16_t N, uint16_t... Codes>
+struct MakeGrayCodeSequence : MakeGrayCodeSequence<N - 1, N - 1, Codes...>
+{
+};
+
+template <uint16_t... Codes>
+struct MakeGrayCodeSequence<0, Codes...>
+{
+    typedef GrayCodeSequence<Codes...> type;
+};
+
+template <typename Sequence>
+struct GrayCodeTable;
+
+template <uint16_t... Codes>
+struct GrayCodeTable<GrayCodeSequence<Codes...>>
+{
+    static constexpr uint8_t toBinary[sizeof...(Codes)]{grayToBinary(Codes)...};
+};
+
+template <uint16_t... Codes>
+constexpr uint8_t GrayCodeTable<GrayCodeSequence<Codes...>>::toBinary[sizeof...(Codes)];
+
+template <uint8_t Tracks>
+class AbsoluteEncoder
+{
+    static_assert((Tracks >= 2) && (Tracks <= 8), "AbsoluteEncoder supports 2 to 8 tracks");
+
+public:
+    static constexpr uint16_t POSITIONS = 1U << Tracks;
+    typedef GrayCodeTable<typename MakeGrayCodeSequence<POSITIONS>::type> Table;
+
+    // readTracks: returns levels of all track pins, track n in bit n (e.g. one port read).
+    // Leave empty if the levels are sampled elsewhere and passed to ::service(levels).
+    explicit AbsoluteEncoder(uint8_t (*readTracks)() = nullptr, bool active = LOW)
+        : readTracks(readTracks),
+          pinActiveState(active){};
+    ~AbsoluteEncoder() { InputActivity::setBusy(busy, false); };
+    AbsoluteEncoder(const AbsoluteEncoder &cpyEncoder) = delete;
+    AbsoluteEncoder &operator=(const AbsoluteEncoder &srcEncoder) = delete;
+
+    // call this every 1 millisecond via timer ISR
+    void service() { service(readTracks()); };
+    // for tracks sampled elsewhere
+    void service(uint8_t levels);
+    // returns positions turned since last poll, across the wrap point like Encoder
+    int16_t getIncrement();
+    // returns positions turned since startup
+    int32_t getAccumulate();
+    // debounced absolute position, 0..POSITIONS-1
+    uint8_t getAbsolutePosition() const { return position; };
+
+private:
+    void handlePosition(uint8_t newPosition);
+
+    uint8_t (*const readTracks)();
+    const bool pinActiveState;
+
+    bool hasPosition{false};
+    uint8_t position{0};
+    uint8_t pendingPosition{0};
+    uint8_t stableTicks{0};
+    volatile int32_t accumulate{0};
+    int32_t lastAccumulate{0};
+    volatile bool busy{false};
+};
+
+// ----------------------------------------------------------------------------
+
+template <uint8_t Tracks>
+void AbsoluteEncoder<Tracks>::service(uint8_t levels)
+{
+    if (pinActiveState == LOW)
+    {
+        levels = ~levels;
+    }
+    uint8_t candidate = Table::toBinary[levels & (POSITIONS - 1)];
+
+    // tracks of a multi-bit transition don't switch at the same time
+    if (candidate != pendingPosition)
+    {
+        pendingPosition = candidate;
+        stableTicks = 1;
+    }
+    else if (stableTicks < ENC_ABSOLUTE_STABLETIME)
+    {
+        ++stableTicks;
+    }
+
+    bool moved = !hasPosition || (candidate != position);
+    if (moved && (stableTicks >= ENC_ABSOLUTE_STABLETIME))
+    {
+        handlePosition(candidate);
+        moved = false;
+    }
+    InputActivity::setBusy(busy, moved);
+}
+
+template <uint8_t Tracks>
+void AbsoluteEncoder<Tracks>::handlePosition(uint8_t newPosition)
+{
+    if (!hasPosition)
+    {
+        // first stable read is the reference, not a turn
+        hasPosition = true;
+        position = newPosition;
+        return;
+    }
+
+    // shortest way around: up to half a turn in either direction
+    int16_t delta = static_cast<uint8_t>(newPosition - position) & (POSITIONS - 1);
+    if (delta >= static_cast<int16_t>(POSITIONS / 2))
+    {
+        delta -= POSITIONS;
+    }
+    position = newPosition;
+    accumulate += delta;
+    InputActivity::notify();
+}
+
+template <uint8_t Tracks>
+int16_t AbsoluteEncoder<Tracks>::getIncrement()
+{
+    int32_t accu = getAccumulate();
+    int16_t increment = static_cast<int16_t>(static_cast<uint32_t>(accu) - static_cast<uint32_t>(lastAccumulate));
+    lastAccumulate = accu;
+    return increment;
+}
+
+// 32 bit reads take several instructions on 8 bit MCUs: read until ::service() didn't interfere
+template <uint8_t Tracks>
+int32_t AbsoluteEncoder<Tracks>::getAccumulate()
+{
+    int32_t accu;
+    do
+    {
+        accu = accumulate;
+    } while (accu != accumulate);
+    return accu;
+}
+
+#endif // CLICKENCODERABSOLUTE_H
@@ -0,0 +1,100 @@
+// ----------------------------------------------------------------------------
+// Awaitable input events for ClickEncoder (C++20 coroutines)
+// ----------------------------------------------------------------------------
+
+#include "ClickEncoderAwait.h"
+
+#if defined(__cpp_impl_coroutine) && !defined(ARDUINO)
+
+// ----------------------------------------------------------------------------
+
+InputEvents::InputEvents(ClickEncoder &clickEncoder)
+    : encoder(clickEncoder.enc), button(clickEncoder.btn)
+{
+}
+// ----------------------------------------------------------------------------
+
+void InputEvents::ButtonAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept
+{
+    this->handle = handle;
+    next = events.buttonWaiters;
+    events.buttonWaiters = this;
+}
+// ----------------------------------------------------------------------------
+
+void InputEvents::RotationAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept
+{
+    this->handle = handle;
+    next = events.rotationWaiters;
+    events.rotationWaiters = this;
+}
+// ----------------------------------------------------------------------------
+
+void InputEvents::handleButton()
+{
+    if (!button)
+    {
+        return;
+    }
+    Button::eButtonStates state = button->getButton();
+    if ((state == Button::Open) || (state == Button::Closed))
+    {
+        return;
+    }
+    // Resume from a separate list: resumed coroutines may await the next event, and
+    // coroutines destroyed meanwhile unlink their awaiter from this list as well.
+    resumingButtons = buttonWaiters;
+    buttonWaiters = nullptr;
+    while (resumingButtons)
+    {
+        ButtonAwaiter *waiter = resumingButtons;
+        resumingButtons = waiter->next;
+        waiter->state = state;
+        waiter->handle.resume();
+    }
+}
+// ----------------------------------------------------------------------------
+
+void InputEvents::handleRotation()
+{
+    if (!encoder)
+    {
+        return;
+    }
+    int16_t increment = encoder->getIncrement();
+    if (!increment)
+    {
+        return;
+    }
+    // Waiters that reached their notches are collected and resumed afterwards,
+    // the others stay linked with their sum so far.
+    RotationAwaiter *waiter = rotationWaiters;
+    rotationWaiters = nullptr;
+    while (waiter)
+    {
+        RotationAwaiter *next = waiter->next;
+        waiter->turned += increment;
+        uint16_t magnitude = (waiter->turned < 0) ? -waiter->turned : waiter->turned;
+        if (magnitude >= waiter->notches)
+        {
+            waiter->next = resumingRotations;
+            resumingRotations = waiter;
+        }
+        else
+        {
+            waiter->next = rotationWaiters;
+            rotationWaiters = waiter;
+        }
+        waiter = next;
+    }
+    // same as for buttons: destroyed coroutines unlink from resumingRotations
+    while (resumingRotations)
+    {
+        RotationAwaiter *done = resumingRotations;
+        resumingRotations = done->next;
+        done->handle.resume();
+    }
+}
+// ----------------------------------------------------------------------------
+
+#endif // __cpp_impl_coroutine
@@ -0,0 +1,148 @@
+// ----------------------------------------------------------------------------
+// Awaitable input events for ClickEncoder (C++20 coroutines)
+// Lets a handler coroutine co_await the next button event or the next turn of
+// at least N notches. Waiting coroutines are resumed from InputEvents::service(),
+// i.e. in the loop that services the instances, without a heap allocation per
+// event: awaiters live in the coroutine frame and are linked into lists.
+// Host builds only, the library itself stays C++11.
+// ----------------------------------------------------------------------------
+
+#ifndef CLICKENCODERAWAIT_H
+#define CLICKENCODERAWAIT_H
+
+#if defined(__cpp_impl_coroutine) && !defined(ARDUINO)
+
+#include "ClickEncoder.h"
+
+#include <coroutine>
+#include <exception>
+
+// Fire-and-forget coroutine type for input handlers.
+// Runs until the first co_await when called, its frame is freed when it returns.
+struct InputTask
+{
+    struct promise_type
+    {
+        InputTask get_return_object() { return {}; };
+        std::suspend_never initial_suspend() noexcept { return {}; };
+        std::suspend_never final_suspend() noexcept { return {}; };
+        void return_void(){};
+        void unhandled_exception() { std::terminate(); };
+    };
+};
+
+class InputEvents
+{
+public:
+    // Result of co_await nextButtonEvent(): Clicked, DoubleClicked, Held, LongPressRepeat or Released.
+    class ButtonAwaiter
+    {
+    public:
+        ButtonAwaiter(const ButtonAwaiter &cpyAwaiter) = delete;
+        ButtonAwaiter &operator=(const ButtonAwaiter &srcAwaiter) = delete;
+        ~ButtonAwaiter()
+        {
+            events.unlink(events.buttonWaiters, this);
+            events.unlink(events.resumingButtons, this);
+        };
+
+        bool await_ready() const noexcept { return false; };
+        void await_suspend(std::coroutine_handle<> handle) noexcept;
+        Button::eButtonStates await_resume() const noexcept { return state; };
+
+    private:
+        friend class InputEvents;
+        explicit ButtonAwaiter(InputEvents &events) : events(events){};
+
+        InputEvents &events;
+        std::coroutine_handle<> handle;
+        ButtonAwaiter *next{nullptr};
+        Button::eButtonStates state{Button::Open};
+    };
+
+    // Result of co_await nextRotation(n): notches turned, at least n in either direction
+    class RotationAwaiter
+    {
+    public:
+        RotationAwaiter(const RotationAwaiter &cpyAwaiter) = delete;
+        RotationAwaiter &operator=(const RotationAwaiter &srcAwaiter) = delete;
+        ~RotationAwaiter()
+        {
+            events.unlink(events.rotationWaiters, this);
+            events.unlink(events.resumingRotations, this);
+        };
+
+        bool await_ready() const noexcept { return false; };
+        void await_suspend(std::coroutine_handle<> handle) noexcept;
+        int16_t await_resume() const noexcept { return turned; };
+
+    private:
+        friend class InputEvents;
+        RotationAwaiter(InputEvents &events, uint16_t notches) : events(events), notches(notches){};
+
+        InputEvents &events;
+        std::coroutine_handle<> handle;
+        RotationAwaiter *next{nullptr};
+        const uint16_t notches;
+        int16_t turned{0};
+    };
+
+    // Either instance may be nullptr if only one kind of event is awaited
+    InputEvents(Encoder *encoder, Button *button) : encoder(encoder), button(button){};
+    explicit InputEvents(ClickEncoder &clickEncoder);
+    InputEvents(const InputEvents &cpyEvents) = delete;
+    InputEvents &operator=(const InputEvents &srcEvents) = delete;
+
+    ButtonAwaiter nextButtonEvent() { return ButtonAwaiter{*this}; };
+    // notches: 1 resumes on every turn
+    RotationAwaiter nextRotation(uint16_t notches = 1) { return RotationAwaiter{*this, notches}; };
+
+    // Call after the instances' ::service() or an event source's dispatch, in the
+    // thread running the coroutines. Reads only what is awaited: events arriving
+    // while nobody waits stay latched for the next awaiter.
+    void service()
+    {
+        if (buttonWaiters)
+        {
+            handleButton();
+        }
+        if (rotationWaiters)
+        {
+            handleRotation();
+        }
+    };
+    bool isAwaited() const { return buttonWaiters || rotationWaiters; };
+
+private:
+    void handleButton();
+    void handleRotation();
+    template <typename Awaiter>
+    static void unlink(Awaiter *&list, Awaiter *awaiter);
+
+    Encoder *const encoder;
+    Button *const button;
+    ButtonAwaiter *buttonWaiters{nullptr};
+    RotationAwaiter *rotationWaiters{nullptr};
+    // waiters of the event being delivered, not resumed yet
+    ButtonAwaiter *resumingButtons{nullptr};
+    RotationAwaiter *resumingRotations{nullptr};
+};
+
+// ----------------------------------------------------------------------------
+
+template <typename Awaiter>
+void InputEvents::unlink(Awaiter *&list, Awaiter *awaiter)
+{
+    // only still linked if the waiting coroutine is destroyed before resumption
+    for (Awaiter **link = &list; *link; link = &(*link)->next)
+    {
+        if (*link == awaiter)
+        {
+            *link = awaiter->next;
+            return;
+        }
+    }
+}
+
+#endif // __cpp_impl_coroutine
+#endif // CLICKENCODERAWAIT_H
@@ -0,0 +1,240 @@
+// ----------------------------------------------------------------------------
+// Frame coalescing for ClickEncoder
+// Sums up all input between two display frames: one summary per instance
+// with net increment, peak velocity and the button events in order, so a
+// UI does the same work per frame however much input arrived.
+// ----------------------------------------------------------------------------
+
+#ifndef CLICKENCODERCOALESCER_H
+#define CLICKENCODERCOALESCER_H
+
+#include "ClickEncoder.h"
+
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+class FrameCoalescer
+{
+public:
+    struct EncoderSummary
+    {
+        // notches within the frame
+        int16_t increment;
+        // fastest turn within the frame, notches per second
+        uint16_t peakVelocity;
+    };
+
+    // Every state except Open in order, up to MAX_EVENTS. Closed and back to back
+    // LongPressRepeats are listed once per run, repeats tells how many repeats there were.
+    struct ButtonSummary
+    {
+        static constexpr uint8_t MAX_EVENTS = 10;
+
+        uint8_t getEventCount() const { return count; };
+        Button::eButtonStates getEvent(uint8_t index) const
+        {
+            return static_cast<Button::eButtonStates>((events >> (3 * index)) & 0x07);
+        };
+        bool contains(Button::eButtonStates state) const
+        {
+            for (uint8_t i = 0; i < count; ++i)
+            {
+                if (getEvent(i) == state)
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+        uint8_t getLongPressRepeatCount() const { return repeats; };
+
+        // 3 bit state codes, first event in the lowest bits
+        uint32_t events;
+        uint8_t count;
+        // LongPressRepeats within the frame, up to 255
+        uint8_t repeats;
+    };
+
+    struct Frame
+    {
+        EncoderSummary encoders[MaxEncoders];
+        ButtonSummary buttons[MaxButtons];
+    };
+
+    FrameCoalescer() = default;
+    FrameCoalescer(const FrameCoalescer &cpyCoalescer) = delete;
+    FrameCoalescer &operator=(const FrameCoalescer &srcCoalescer) = delete;
+
+    // Button events are taken by the coalescer: don't call getButton() on added buttons
+    bool add(Encoder &encoder);
+    bool add(Button &button);
+
+    // call this every 1 millisecond via timer ISR: services all added instances, then collects
+    void service();
+    // same, for instances serviced elsewhere (e.g. by an InputSource) right before
+    void collect();
+    // Call at the frame boundary. Returns everything since the previous call.
+    void takeFrame(Frame &frame);
+
+private:
+    void handleEncoder(uint8_t index, volatile EncoderSummary &summary);
+    void handleButton(uint8_t index, volatile ButtonSummary &summary);
+
+    Encoder *encoders[MaxEncoders]{};
+    Button *buttons[MaxButtons]{};
+    uint8_t encoderCount{0};
+    uint8_t buttonCount{0};
+
+    // ::service() collects into the active buffer, takeFrame() flips
+    volatile Frame buffers[2]{};
+    volatile uint8_t active{0};
+
+    // ISR side, across frames
+    int32_t lastSteps[MaxEncoders]{};
+    int32_t lastNotches[MaxEncoders]{};
+    uint16_t ticksSinceNotch[MaxEncoders]{};
+};
+
+// ----------------------------------------------------------------------------
+
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+bool FrameCoalescer<MaxEncoders, MaxButtons>::add(Encoder &encoder)
+{
+    if (encoderCount >= MaxEncoders)
+    {
+        return false;
+    }
+    lastSteps[encoderCount] = encoder.readAccumulate();
+    lastNotches[encoderCount] = lastSteps[encoderCount] / encoder.stepsPerNotch;
+    ticksSinceNotch[encoderCount] = UINT16_MAX;
+    encoders[encoderCount] = &encoder;
+    ++encoderCount;
+    return true;
+}
+
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+bool FrameCoalescer<MaxEncoders, MaxButtons>::add(Button &button)
+{
+    if (buttonCount >= MaxButtons)
+    {
+        return false;
+    }
+    buttons[buttonCount] = &button;
+    ++buttonCount;
+    return true;
+}
+
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+void FrameCoalescer<MaxEncoders, MaxButtons>::service()
+{
+    for (uint8_t i = 0; i < encoderCount; ++i)
+    {
+        encoders[i]->service();
+    }
+    for (uint8_t i = 0; i < buttonCount; ++i)
+    {
+        buttons[i]->service();
+    }
+    collect();
+}
+
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+void FrameCoalescer<MaxEncoders, MaxButtons>::collect()
+{
+    volatile Frame &frame = buffers[active];
+    for (uint8_t i = 0; i < encoderCount; ++i)
+    {
+        handleEncoder(i, frame.encoders[i]);
+    }
+    for (uint8_t i = 0; i < buttonCount; ++i)
+    {
+        handleButton(i, frame.buttons[i]);
+    }
+}
+
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+void FrameCoalescer<MaxEncoders, MaxButtons>::handleEncoder(uint8_t index, volatile EncoderSummary &summary)
+{
+    if (ticksSinceNotch[index] < UINT16_MAX)
+    {
+        ++ticksSinceNotch[index];
+    }
+
+    // same context as ::service(): no tearing, and no division unless moved
+    int32_t steps = encoders[index]->encoderAccumulate;
+    if (steps == lastSteps[index])
+    {
+        return;
+    }
+    lastSteps[index] = steps;
+    int32_t notches = steps / encoders[index]->stepsPerNotch;
+    int16_t delta = static_cast<int16_t>(notches - lastNotches[index]);
+    if (delta == 0)
+    {
+        return;
+    }
+    lastNotches[index] = notches;
+
+    summary.increment += delta;
+    uint32_t velocity = (static_cast<uint32_t>(delta < 0 ? -delta : delta) * 1000) / ticksSinceNotch[index];
+    ticksSinceNotch[index] = 0;
+    if (velocity > summary.peakVelocity)
+    {
+        summary.peakVelocity = (velocity > UINT16_MAX) ? UINT16_MAX : velocity;
+    }
+}
+
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+void FrameCoalescer<MaxEncoders, MaxButtons>::handleButton(uint8_t index, volatile ButtonSummary &summary)
+{
+    uint8_t state = buttons[index]->getButton();
+    if (state == Button::Open)
+    {
+        return;
+    }
+    if (state == Button::LongPressRepeat)
+    {
+        uint8_t repeats = buttons[index]->getLongPressRepeatCount();
+        summary.repeats = (summary.repeats > (UINT8_MAX - repeats)) ? UINT8_MAX : summary.repeats + repeats;
+    }
+
+    // Closed is reported on every read while pressed, and repeats are counted
+    uint8_t count = summary.count;
+    if ((count > 0) && ((state == Button::Closed) || (state == Button::LongPressRepeat)) &&
+        (((summary.events >> (3 * (count - 1))) & 0x07) == state))
+    {
+        return;
+    }
+    if (count >= ButtonSummary::MAX_EVENTS)
+    {
+        return;
+    }
+    summary.events |= static_cast<uint32_t>(state) << (3 * count);
+    summary.count = count + 1;
+}
+
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+void FrameCoalescer<MaxEncoders, MaxButtons>::takeFrame(Frame &frame)
+{
+    // single byte write: the next ::service() collects into the other buffer
+    uint8_t finished = active;
+    active = finished ^ 1;
+
+    volatile Frame &source = buffers[finished];
+    for (uint8_t i = 0; i < encoderCount; ++i)
+    {
+        frame.encoders[i].increment = source.encoders[i].increment;
+        frame.encoders[i].peakVelocity = source.encoders[i].peakVelocity;
+        source.encoders[i].increment = 0;
+        source.encoders[i].peakVelocity = 0;
+    }
+    for (uint8_t i = 0; i < buttonCount; ++i)
+    {
+        frame.buttons[i].events = source.buttons[i].events;
+        frame.buttons[i].count = source.buttons[i].count;
+        frame.buttons[i].repeats = source.buttons[i].repeats;
+        source.buttons[i].events = 0;
+        source.buttons[i].count = 0;
+        source.buttons[i].repeats = 0;
+    }
+}
+
+#endif // CLICKENCODERCOALESCER_H
@@ -0,0 +1,34 @@
+// ----------------------------------------------------------------------------
+// Host build support for ClickEncoder
+// Used when neither the Arduino core nor ArduinoFake is available, e.g. for
+// benchmarks and backends on Linux. Provides the few Arduino symbols the
+// library needs. Pin levels are simulated, set them via hostPinLevels().
+// ----------------------------------------------------------------------------
+
+#ifndef CLICKENCODERHOST_H
+#define CLICKENCODERHOST_H
+
+#include <stdint.h>
+
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x0
+#define INPUT_PULLUP 0x2
+
+constexpr uint8_t HOST_PIN_COUNT = 64;
+
+// Simulated pin levels, indexed by pin number
+inline volatile uint8_t *hostPinLevels()
+{
+    static volatile uint8_t levels[HOST_PIN_COUNT]{};
+    return levels;
+}
+
+inline void pinMode(uint8_t, uint8_t) {}
+
+inline int digitalRead(uint8_t pin)
+{
+    return hostPinLevels()[pin % HOST_PIN_COUNT];
+}
+
+#endif // CLICKENCODERHOST_H
@@ -0,0 +1,48 @@
+// ----------------------------------------------------------------------------
+// Input sources for ClickEncoder
+// ----------------------------------------------------------------------------
+
+#include "ClickEncoderInput.h"
+
+// ----------------------------------------------------------------------------
+
+bool InputSource::attach(Encoder &encoder, uint8_t bitA, uint8_t bitB)
+{
+    if ((channelCount >= capacity) || (bitA >= snapshotBits) || (bitB >= snapshotBits))
+    {
+        return false;
+    }
+    channels[channelCount++] = Channel{&encoder, nullptr,
+                                       static_cast<uint8_t>(bitA >> 3), static_cast<uint8_t>(1 << (bitA & 7)),
+                                       static_cast<uint8_t>(bitB >> 3), static_cast<uint8_t>(1 << (bitB & 7))};
+    return true;
+}
+
+bool InputSource::attach(Button &button, uint8_t bit)
+{
+    if ((channelCount >= capacity) || (bit >= snapshotBits))
+    {
+        return false;
+    }
+    channels[channelCount++] = Channel{nullptr, &button,
+                                       static_cast<uint8_t>(bit >> 3), static_cast<uint8_t>(1 << (bit & 7)),
+                                       static_cast<uint8_t>(bit >> 3), static_cast<uint8_t>(1 << (bit & 7))};
+    return true;
+}
+
+void InputSource::fanOut(const uint8_t *snapshot)
+{
+    for (uint8_t i = 0; i < channelCount; ++i)
+    {
+        const Channel &channel = channels[i];
+        bool levelA = snapshot[channel.byteA] & channel.maskA;
+        if (channel.button)
+        {
+            channel.button->service(levelA);
+        }
+        else
+        {
+            channel.encoder->service(levelA, snapshot[channel.byteB] & channel.maskB);
+        }
+    }
+}
@@ -0,0 +1,53 @@
+// ----------------------------------------------------------------------------
+// Input sources for ClickEncoder
+// Sample many input lines at once (port expanders, shift registers) and fan
+// the snapshot out to the attached Encoder and Button instances, instead of
+// calling digitalRead() per pin.
+// ----------------------------------------------------------------------------
+
+#ifndef CLICKENCODERINPUT_H
+#define CLICKENCODERINPUT_H
+
+#include "ClickEncoder.h"
+
+class InputSource
+{
+public:
+    virtual ~InputSource() = default;
+    InputSource(const InputSource &cpySource) = delete;
+    InputSource &operator=(const InputSource &srcSource) = delete;
+
+    // bit: position of the line within the snapshot. Returns false if full or out of the snapshot.
+    bool attach(Encoder &encoder, uint8_t bitA, uint8_t bitB);
+    bool attach(Button &button, uint8_t bit);
+
+    // call this every 1 millisecond via timer ISR
+    virtual void service() = 0;
+
+protected:
+    struct Channel
+    {
+        Encoder *encoder;
+        Button *button;
+        // position of the lines within the snapshot, resolved when attached
+        uint8_t byteA;
+        uint8_t maskA;
+        uint8_t byteB;
+        uint8_t maskB;
+    };
+
+    // channel table is sized and owned by the input source implementation, snapshotBits: lines per snapshot
+    InputSource(Channel *channels, uint8_t capacity, uint16_t snapshotBits)
+        : channels(channels), capacity(capacity), snapshotBits(snapshotBits){};
+
+    // Calls ::service() of every attached instance. Bit n of snapshot is bit (n % 8) of byte (n / 8).
+    void fanOut(const uint8_t *snapshot);
+
+private:
+    Channel *const channels;
+    const uint8_t capacity;
+    const uint16_t snapshotBits;
+    uint8_t channelCount{0};
+};
+
+#endif // CLICKENCODERINPUT_H
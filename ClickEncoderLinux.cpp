@@ -0,0 +1,273 @@
+// ----------------------------------------------------------------------------
+// Linux GPIO character device backend for ClickEncoder
+// ----------------------------------------------------------------------------
+
+#include "ClickEncoderLinux.h"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+// ----------------------------------------------------------------------------
+
+GpioEventSource::GpioEventSource(int eventFd) : eventFd(eventFd)
+{
+    // events are read until the descriptor runs empty
+    int flags = fcntl(eventFd, F_GETFL);
+    if ((flags < 0) || (fcntl(eventFd, F_SETFL, flags | O_NONBLOCK) < 0))
+    {
+        return;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0)
+    {
+        return;
+    }
+
+    epoll_event interest{};
+    interest.events = EPOLLIN;
+    interest.data.fd = eventFd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, eventFd, &interest) < 0)
+    {
+        close(epollFd);
+        epollFd = -1;
+    }
+}
+
+GpioEventSource::~GpioEventSource()
+{
+    // eventFd is owned by the caller
+    if (epollFd >= 0)
+    {
+        close(epollFd);
+    }
+}
+
+bool GpioEventSource::attach(Encoder &encoder, uint32_t offsetA, uint32_t offsetB, bool levelA, bool levelB)
+{
+    if (channelCount >= GPIO_MAX_CHANNELS)
+    {
+        return false;
+    }
+    channels[channelCount++] = Channel{&encoder, nullptr, offsetA, offsetB, levelA, levelB};
+    // the first edge is a step from these levels
+    encoder.prime(levelA, levelB);
+    return true;
+}
+
+bool GpioEventSource::attach(Button &button, uint32_t offset, bool level)
+{
+    if (channelCount >= GPIO_MAX_CHANNELS)
+    {
+        return false;
+    }
+    channels[channelCount++] = Channel{nullptr, &button, offset, offset, level, level};
+    return true;
+}
+
+bool GpioEventSource::readLevels(const uint32_t *offsets, uint8_t count)
+{
+    if (count > GPIO_V2_LINES_MAX)
+    {
+        return false;
+    }
+
+    // bits and mask are indexed by position in the request, not by offset
+    gpio_v2_line_values values{};
+    values.mask = (count < 64) ? ((1ULL << count) - 1) : ~0ULL;
+    if (ioctl(eventFd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0)
+    {
+        return false;
+    }
+
+    for (uint8_t line = 0; line < count; ++line)
+    {
+        bool level = (values.bits >> line) & 1;
+        for (uint8_t i = 0; i < channelCount; ++i)
+        {
+            Channel &channel = channels[i];
+            if (channel.offsetA == offsets[line])
+            {
+                channel.levelA = level;
+            }
+            if (channel.offsetB == offsets[line])
+            {
+                channel.levelB = level;
+            }
+        }
+    }
+    for (uint8_t i = 0; i < channelCount; ++i)
+    {
+        if (channels[i].encoder)
+        {
+            channels[i].encoder->prime(channels[i].levelA, channels[i].levelB);
+        }
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+
+int GpioEventSource::dispatch(int timeoutMs)
+{
+    epoll_event ready;
+    int readyCount = epoll_wait(epollFd, &ready, 1, timeoutMs);
+    if (readyCount <= 0)
+    {
+        return ((readyCount == 0) || (errno == EINTR)) ? 0 : -1;
+    }
+
+    int handled{0};
+    gpio_v2_line_event events[16];
+    while (true)
+    {
+        ssize_t bytes = read(eventFd, events, sizeof(events));
+        if (bytes < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? handled : -1;
+        }
+        if (bytes == 0)
+        {
+            // writer side closed (pipe, socket)
+            return (handled > 0) ? handled : -1;
+        }
+
+        // records are delivered whole, no partial reads
+        size_t count = static_cast<size_t>(bytes) / sizeof(gpio_v2_line_event);
+        for (size_t i = 0; i < count; ++i)
+        {
+            handleEvent(events[i]);
+            ++handled;
+        }
+    }
+}
+
+void GpioEventSource::handleEvent(const gpio_v2_line_event &event)
+{
+    // let time pass with the levels before this edge
+    serviceUntil(event.timestamp_ns);
+
+    bool level = (event.id == GPIO_V2_LINE_EVENT_RISING_EDGE);
+    for (uint8_t i = 0; i < channelCount; ++i)
+    {
+        Channel &channel = channels[i];
+        if ((channel.offsetA != event.offset) && (channel.offsetB != event.offset))
+        {
+            continue;
+        }
+
+        if (channel.button)
+        {
+            // button is debounced by sampling, picks the level up with next tick
+            channel.levelA = level;
+            continue;
+        }
+
+        if (channel.offsetA == event.offset)
+        {
+            channel.levelA = level;
+        }
+        else
+        {
+            channel.levelB = level;
+        }
+        // decode every edge, even multiple ones within one tick
+        channel.encoder->update(channel.levelA, channel.levelB);
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void GpioEventSource::serviceUntil(uint64_t timestampNs)
+{
+    if (nextTickNs == 0)
+    {
+        // first event starts the time base
+        nextTickNs = timestampNs + GPIO_SERVICE_NS;
+        return;
+    }
+    if (timestampNs < nextTickNs)
+    {
+        return;
+    }
+
+    uint64_t elapsedTicks = ((timestampNs - nextTickNs) / GPIO_SERVICE_NS) + 1;
+    nextTickNs += elapsedTicks * GPIO_SERVICE_NS;
+    if (elapsedTicks > GPIO_MAX_CATCHUP_TICKS)
+    {
+        // all timeouts have long elapsed, no need to simulate the whole pause
+        elapsedTicks = GPIO_MAX_CATCHUP_TICKS;
+    }
+    for (uint64_t tick = 0; tick < elapsedTicks; ++tick)
+    {
+        serviceChannels();
+    }
+}
+
+void GpioEventSource::service()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    serviceUntil(static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec));
+}
+
+void GpioEventSource::serviceChannels()
+{
+    for (uint8_t i = 0; i < channelCount; ++i)
+    {
+        Channel &channel = channels[i];
+        if (channel.button)
+        {
+            channel.button->service(channel.levelA);
+        }
+        else
+        {
+            channel.encoder->service(channel.levelA, channel.levelB);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+int GpioEventSource::requestLines(const char *chipPath, const uint32_t *offsets, uint8_t count, bool pullUp)
+{
+    if (count > GPIO_V2_LINES_MAX)
+    {
+        return -1;
+    }
+
+    int chipFd = open(chipPath, O_RDONLY | O_CLOEXEC);
+    if (chipFd < 0)
+    {
+        return -1;
+    }
+
+    gpio_v2_line_request request{};
+    memcpy(request.offsets, offsets, count * sizeof(uint32_t));
+    strncpy(request.consumer, "ClickEncoder", sizeof(request.consumer) - 1);
+    request.config.flags = GPIO_V2_LINE_FLAG_INPUT |
+                           GPIO_V2_LINE_FLAG_EDGE_RISING |
+                           GPIO_V2_LINE_FLAG_EDGE_FALLING;
+    if (pullUp)
+    {
+        request.config.flags |= GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+    }
+    request.num_lines = count;
+
+    int result = ioctl(chipFd, GPIO_V2_GET_LINE_IOCTL, &request);
+    close(chipFd);
+    return (result < 0) ? -1 : request.fd;
+}
+
+#endif // __linux__
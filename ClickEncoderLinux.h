@@ -0,0 +1,73 @@
+// ----------------------------------------------------------------------------
+// Linux GPIO character device backend for ClickEncoder
+// Feeds kernel-timestamped line events (A/B/BTN edges) into Encoder and
+// Button instances event by event, without a polling thread.
+// Host builds only, see ClickEncoderHost.h.
+// ----------------------------------------------------------------------------
+
+#ifndef CLICKENCODERLINUX_H
+#define CLICKENCODERLINUX_H
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "ClickEncoder.h"
+
+#include <linux/gpio.h>
+
+constexpr uint8_t GPIO_MAX_CHANNELS = 8;          // Encoder or Button instances per event source
+constexpr uint32_t GPIO_SERVICE_NS = 1000000;     // ::service() interval the library is tuned for (1ms)
+constexpr uint16_t GPIO_MAX_CATCHUP_TICKS = 5000; // ::service() calls at most to catch up after a pause
+
+class GpioEventSource
+{
+public:
+    // eventFd delivers struct gpio_v2_line_event records, e.g. requested by requestLines().
+    // Any other file descriptor (pipe, socket) delivering the same records works as well.
+    explicit GpioEventSource(int eventFd);
+    ~GpioEventSource();
+    GpioEventSource(const GpioEventSource &cpySource) = delete;
+    GpioEventSource &operator=(const GpioEventSource &srcSource) = delete;
+
+    bool isValid() const { return epollFd >= 0; };
+    // Line offsets as reported in events, and line levels to start with (idle with pull-ups).
+    bool attach(Encoder &encoder, uint32_t offsetA, uint32_t offsetB, bool levelA = HIGH, bool levelB = HIGH);
+    bool attach(Button &button, uint32_t offset, bool level = HIGH);
+    // Reads the current levels of the lines requested by requestLines() and starts the
+    // attached instances with them. Call after attach(). Returns false if eventFd is no line request.
+    bool readLevels(const uint32_t *offsets, uint8_t count);
+
+    // Waits up to timeoutMs (-1: forever) for line events and feeds them to the attached instances.
+    // Returns number of events handled, -1 on error.
+    int dispatch(int timeoutMs);
+    // Runs ::service() of all attached instances for the time elapsed until timestampNs (CLOCK_MONOTONIC).
+    // Call after dispatch() so timeouts (Held, DoubleClick) elapse without line events.
+    void serviceUntil(uint64_t timestampNs);
+    void service();
+
+    // Requests lines of a gpiochip (e.g. "/dev/gpiochip0") as inputs with edge events on both edges.
+    // Returns file descriptor delivering the events, -1 on error.
+    static int requestLines(const char *chipPath, const uint32_t *offsets, uint8_t count, bool pullUp = true);
+
+private:
+    struct Channel
+    {
+        Encoder *encoder;
+        Button *button;
+        uint32_t offsetA;
+        uint32_t offsetB;
+        bool levelA;
+        bool levelB;
+    };
+
+    void handleEvent(const gpio_v2_line_event &event);
+    void serviceChannels();
+
+    const int eventFd;
+    int epollFd{-1};
+    Channel channels[GPIO_MAX_CHANNELS]{};
+    uint8_t channelCount{0};
+    uint64_t nextTickNs{0};
+};
+
+#endif // __linux__
+#endif // CLICKENCODERLINUX_H
@@ -0,0 +1,74 @@
+// ----------------------------------------------------------------------------
+// MCP23017 I2C port expander input source for ClickEncoder
+// ----------------------------------------------------------------------------
+
+#include "ClickEncoderMCP23017.h"
+
+// register addresses for IOCON.BANK = 0, A and B registers are adjacent
+constexpr uint8_t MCP23017_IODIRA = 0x00;
+constexpr uint8_t MCP23017_GPINTENA = 0x04;
+constexpr uint8_t MCP23017_IOCON = 0x0A;
+constexpr uint8_t MCP23017_GPPUA = 0x0C;
+constexpr uint8_t MCP23017_GPIOA = 0x12;
+constexpr uint8_t MCP23017_IOCON_MIRROR = 0x40;
+
+// ----------------------------------------------------------------------------
+
+MCP23017Input::MCP23017Input(I2cBus &bus, uint8_t address) : InputSource(channelTable, MCP23017_MAX_CHANNELS, MCP23017_LINES),
+                                                               bus(bus),
+                                                               address(address)
+{
+}
+
+bool MCP23017Input::begin()
+{
+    const uint8_t allLines[2]{0xFF, 0xFF};
+    const uint8_t mirror{MCP23017_IOCON_MIRROR};
+    changePending = true;
+    return bus.write(address, MCP23017_IOCON, &mirror, 1) &&
+           bus.write(address, MCP23017_IODIRA, allLines, 2) &&
+           bus.write(address, MCP23017_GPPUA, allLines, 2) &&
+           bus.write(address, MCP23017_GPINTENA, allLines, 2);
+}
+
+void MCP23017Input::service()
+{
+    handleTransfer();
+    // instances need their time base even if nothing changed
+    fanOut(snapshot);
+}
+
+void MCP23017Input::handleTransfer()
+{
+    if (transferActive)
+    {
+        I2cBus::eTransferStates state = bus.getTransferState();
+        if (state == I2cBus::Pending)
+        {
+            return;
+        }
+
+        transferActive = false;
+        if (state == I2cBus::Complete)
+        {
+            snapshot[0] = readBuffer[0];
+            snapshot[1] = readBuffer[1];
+        }
+        else
+        {
+            changePending = true; // retry
+        }
+    }
+
+    if (!changePending)
+    {
+        return;
+    }
+
+    // reading GPIOA/GPIOB also clears the expander's INT
+    if (bus.startRead(address, MCP23017_GPIOA, readBuffer, 2))
+    {
+        changePending = false;
+        transferActive = true;
+    }
+}
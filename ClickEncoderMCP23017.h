@@ -0,0 +1,63 @@
+// ----------------------------------------------------------------------------
+// MCP23017 I2C port expander input source for ClickEncoder
+// Reads both 8 bit ports in one non-blocking transaction, only when the
+// expander's INT line signals a change, and fans the snapshot out to all
+// attached Encoder and Button instances.
+// ----------------------------------------------------------------------------
+
+#ifndef CLICKENCODERMCP23017_H
+#define CLICKENCODERMCP23017_H
+
+#include "ClickEncoderInput.h"
+
+constexpr uint8_t MCP23017_MAX_CHANNELS = 16; // Encoder or Button instances per expander
+constexpr uint8_t MCP23017_LINES = 16;        // GPA0..7 are bits 0..7, GPB0..7 bits 8..15
+
+// Non-blocking I2C bus, e.g. an interrupt driven TWI driver.
+class I2cBus
+{
+public:
+    enum eTransferStates
+    {
+        Pending = 0,
+        Complete,
+        Failed
+    };
+
+    virtual ~I2cBus() = default;
+
+    // Starts reading length bytes, beginning at register reg. Returns false if the bus is busy.
+    // buffer must stay valid until the transfer is no longer Pending.
+    virtual bool startRead(uint8_t address, uint8_t reg, uint8_t *buffer, uint8_t length) = 0;
+    // State of the transfer started last
+    virtual eTransferStates getTransferState() = 0;
+    // Blocking write, only used for setup outside of ISRs
+    virtual bool write(uint8_t address, uint8_t reg, const uint8_t *data, uint8_t length) = 0;
+};
+
+class MCP23017Input : public InputSource
+{
+public:
+    // address: 0x20..0x27 depending on A0..A2 pins
+    explicit MCP23017Input(I2cBus &bus, uint8_t address = 0x20);
+
+    // Configures all 16 lines as inputs with pull-ups and INT on change (INTA/INTB mirrored).
+    bool begin();
+    // call this from the INT line's pin change interrupt
+    void onInterrupt() { changePending = true; };
+    // call this every 1 millisecond via timer ISR
+    void service() override;
+
+private:
+    void handleTransfer();
+
+    Channel channelTable[MCP23017_MAX_CHANNELS]{};
+    I2cBus &bus;
+    const uint8_t address;
+    volatile bool changePending{true}; // initial read
+    bool transferActive{false};
+    uint8_t readBuffer[2]{0xFF, 0xFF};
+    uint8_t snapshot[2]{0xFF, 0xFF};
+};
+
+#endif // CLICKENCODERMCP23017_H
@@ -0,0 +1,174 @@
+// ----------------------------------------------------------------------------
+// Button matrix scanner for ClickEncoder
+// Drives one row per service call and reads all columns at once. Every key
+// reports the same states as Button (Click, DoubleClick, Held,
+// LongPressRepeat). Key combinations that cause ghosting are flagged.
+// ----------------------------------------------------------------------------
+
+#ifndef CLICKENCODERMATRIX_H
+#define CLICKENCODERMATRIX_H
+
+#include "ClickEncoder.h"
+
+// smallest type holding one bit per column
+template <bool Wide>
+struct MatrixColumnBits
+{
+    typedef uint8_t type;
+};
+
+template <>
+struct MatrixColumnBits<true>
+{
+    typedef uint16_t type;
+};
+
+template <uint8_t Rows, uint8_t Cols>
+class ButtonMatrix
+{
+    static_assert(Cols <= 16, "ButtonMatrix supports up to 16 columns");
+    static_assert(Rows <= ENC_BUTTONINTERVAL, "every row must be scanned once per ENC_BUTTONINTERVAL");
+
+public:
+    typedef typename MatrixColumnBits<(Cols > 8)>::type ColumnBits;
+
+    // selectRow: drives given row to active state, all others inactive
+    // readColumns: returns levels of all column pins, column n in bit n
+    ButtonMatrix(void (*selectRow)(uint8_t row), uint16_t (*readColumns)(), bool active = LOW)
+        : selectRow(selectRow),
+          readColumns(readColumns),
+          pinActiveState(active){};
+    ~ButtonMatrix() { InputActivity::setBusy(busy, false); };
+    ButtonMatrix(const ButtonMatrix &cpyMatrix) = delete;
+    ButtonMatrix &operator=(const ButtonMatrix &srcMatrix) = delete;
+
+    // call this every 1 millisecond via timer ISR
+    void service();
+    Button::eButtonStates getButton(uint8_t row, uint8_t col) { return keys[row][col].getButton(); };
+    bool isPressed(uint8_t row, uint8_t col) const { return (pressedColumns[row] >> col) & 1; };
+    // true if pressed keys form a rectangle, where a further key would read as pressed.
+    // New presses on the involved keys are ignored until the rectangle is resolved.
+    bool hasGhosting() const { return ghostingRows != 0; };
+    void setDoubleClickEnabled(const bool b) { doubleClickEnabled = b; };
+    void setLongPressRepeatEnabled(const bool b) { longPressRepeatEnabled = b; };
+    void setLongPressRepeatRamp(uint16_t startInterval, uint16_t minInterval, uint8_t rampSteps)
+    {
+        repeatRamp.configure(startInterval, minInterval, rampSteps);
+    };
+    uint8_t getLongPressRepeatCount(uint8_t row, uint8_t col) const { return keys[row][col].getLongPressRepeatCount(); };
+
+private:
+    void handleRow(uint8_t row, ColumnBits columns);
+    ColumnBits handleGhosting(uint8_t row, ColumnBits columns);
+
+    void (*const selectRow)(uint8_t row);
+    uint16_t (*const readColumns)();
+    const bool pinActiveState;
+
+    bool doubleClickEnabled{false};
+    bool longPressRepeatEnabled{false};
+    Button::RepeatRamp repeatRamp;
+    Button::Key keys[Rows][Cols]{};
+    // debounced state, one bit per key
+    ColumnBits pressedColumns[Rows]{};
+    // keys that are pressed or wait for a second click
+    ColumnBits busyColumns[Rows]{};
+    uint32_t ghostingRows{0};
+    // first call reads no row and only selects row 0, so it has settled when read
+    uint8_t scanTick{ENC_BUTTONINTERVAL};
+    volatile bool busy{false};
+};
+
+// ----------------------------------------------------------------------------
+
+template <uint8_t Rows, uint8_t Cols>
+void ButtonMatrix<Rows, Cols>::service()
+{
+    // Like Button, each key is sampled once per ENC_BUTTONINTERVAL.
+    // Rows are spread over the interval, one row per call.
+    if (scanTick < Rows)
+    {
+        ColumnBits columns = static_cast<ColumnBits>(readColumns());
+        if (pinActiveState == LOW)
+        {
+            columns = ~columns;
+        }
+        handleRow(scanTick, columns & static_cast<ColumnBits>((1UL << Cols) - 1));
+    }
+
+    ++scanTick;
+    if (scanTick >= ENC_BUTTONINTERVAL)
+    {
+        scanTick = 0;
+    }
+    // select the row read next call, so its lines have settled
+    if (scanTick < Rows)
+    {
+        selectRow(scanTick);
+    }
+}
+
+template <uint8_t Rows, uint8_t Cols>
+void ButtonMatrix<Rows, Cols>::handleRow(uint8_t row, ColumnBits columns)
+{
+    columns = handleGhosting(row, columns);
+
+    // idle keys of an idle row need no update at all
+    ColumnBits pending = columns | busyColumns[row];
+    pressedColumns[row] = columns;
+    ColumnBits stillBusy{0};
+    for (uint8_t col = 0; pending; ++col, pending >>= 1)
+    {
+        if (!(pending & 1))
+        {
+            continue;
+        }
+
+        Button::Key &key = keys[row][col];
+        if (key.handle((columns >> col) & 1, doubleClickEnabled, longPressRepeatEnabled, repeatRamp))
+        {
+            InputActivity::notify();
+        }
+        if (key.isBusy())
+        {
+            stillBusy |= static_cast<ColumnBits>(1U << col);
+        }
+    }
+    busyColumns[row] = stillBusy;
+
+    if (row == Rows - 1)
+    {
+        bool anyBusy{false};
+        for (uint8_t i = 0; i < Rows; ++i)
+        {
+            anyBusy |= (busyColumns[i] != 0);
+        }
+        InputActivity::setBusy(busy, anyBusy);
+    }
+}
+
+template <uint8_t Rows, uint8_t Cols>
+typename ButtonMatrix<Rows, Cols>::ColumnBits ButtonMatrix<Rows, Cols>::handleGhosting(uint8_t row, ColumnBits columns)
+{
+    ghostingRows &= ~(1UL << row);
+    // a rectangle needs at least 2 columns in both rows
+    if (!(columns & (columns - 1)))
+    {
+        return columns;
+    }
+
+    for (uint8_t other = 0; other < Rows; ++other)
+    {
+        ColumnBits shared = columns & pressedColumns[other];
+        if ((other == row) || !(shared & (shared - 1)))
+        {
+            continue;
+        }
+        // ambiguous: any of the shared keys might be a ghost. Keep their last state.
+        ghostingRows |= (1UL << row);
+        columns = (columns & ~shared) | (pressedColumns[row] & shared);
+    }
+    return columns;
+}
+
+#endif // CLICKENCODERMATRIX_H
@@ -0,0 +1,210 @@
+// ----------------------------------------------------------------------------
+// Panel snapshot for ClickEncoder
+// Captures all registered Encoder and Button instances as of one service
+// tick. The ISR publishes double buffered frames, the main loop copies the
+// latest one without disabling interrupts.
+// ----------------------------------------------------------------------------
+
+#ifndef CLICKENCODERPANEL_H
+#define CLICKENCODERPANEL_H
+
+#include "ClickEncoder.h"
+
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+class Panel
+{
+public:
+    struct Frame
+    {
+        // service tick the frame was published at
+        uint8_t sequence;
+        // notches since the previous snapshot(), in order of add()
+        int16_t increments[MaxEncoders];
+        // latest event since the previous snapshot(), else Open or Closed
+        Button::eButtonStates buttons[MaxButtons];
+        // LongPressRepeats since the previous snapshot(), up to 255
+        uint8_t repeats[MaxButtons];
+    };
+
+    Panel() = default;
+    Panel(const Panel &cpyPanel) = delete;
+    Panel &operator=(const Panel &srcPanel) = delete;
+
+    // Button events are taken by the panel: don't call getButton() on added buttons
+    bool add(Encoder &encoder);
+    bool add(Button &button);
+
+    // call this every 1 millisecond via timer ISR: services all added instances, then publishes
+    void service();
+    // same, for instances serviced elsewhere (e.g. by an InputSource) right before
+    void publish();
+    // copies the latest published frame, acknowledges its button events
+    void snapshot(Frame &frame);
+
+private:
+    struct Published
+    {
+        int32_t steps[MaxEncoders];
+        uint8_t buttons[MaxButtons];
+        uint8_t repeats[MaxButtons];
+    };
+
+    static bool isEvent(uint8_t state) { return (state != Button::Open) && (state != Button::Closed); };
+    void handleAcknowledge();
+
+    Encoder *encoders[MaxEncoders]{};
+    Button *buttons[MaxButtons]{};
+    uint8_t encoderCount{0};
+    uint8_t buttonCount{0};
+
+    // ISR side
+    volatile Published published[2]{};
+    volatile uint8_t sequence{0};
+    // events are reported once by getButton(): keep the latest until acknowledged
+    uint8_t latched[MaxButtons]{};
+    // frame an event was first published in
+    uint8_t latchedSequence[MaxButtons]{};
+    uint8_t lastAcknowledged{0};
+    // free running, like the encoders' steps
+    uint8_t repeatTotal[MaxButtons]{};
+
+    // main loop side
+    volatile uint8_t acknowledged{0};
+    int32_t lastAccumulate[MaxEncoders]{};
+    uint8_t lastRepeatTotal[MaxButtons]{};
+};
+
+// ----------------------------------------------------------------------------
+
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+bool Panel<MaxEncoders, MaxButtons>::add(Encoder &encoder)
+{
+    if (encoderCount >= MaxEncoders)
+    {
+        return false;
+    }
+    encoders[encoderCount] = &encoder;
+    ++encoderCount;
+    return true;
+}
+
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+bool Panel<MaxEncoders, MaxButtons>::add(Button &button)
+{
+    if (buttonCount >= MaxButtons)
+    {
+        return false;
+    }
+    buttons[buttonCount] = &button;
+    ++buttonCount;
+    return true;
+}
+
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+void Panel<MaxEncoders, MaxButtons>::service()
+{
+    for (uint8_t i = 0; i < encoderCount; ++i)
+    {
+        encoders[i]->service();
+    }
+    for (uint8_t i = 0; i < buttonCount; ++i)
+    {
+        buttons[i]->service();
+    }
+    publish();
+}
+
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+void Panel<MaxEncoders, MaxButtons>::publish()
+{
+    handleAcknowledge();
+
+    // fill the buffer not being read, then flip
+    uint8_t next = sequence + 1;
+    volatile Published &frame = published[next & 1];
+    for (uint8_t i = 0; i < encoderCount; ++i)
+    {
+        // raw steps: no division in the ISR, same context as ::service() so no tearing
+        frame.steps[i] = encoders[i]->encoderAccumulate;
+    }
+    for (uint8_t i = 0; i < buttonCount; ++i)
+    {
+        uint8_t state = buttons[i]->getButton();
+        if (state == Button::LongPressRepeat)
+        {
+            repeatTotal[i] += buttons[i]->getLongPressRepeatCount();
+        }
+        if (isEvent(state))
+        {
+            latched[i] = state;
+            latchedSequence[i] = next;
+        }
+        else if (!isEvent(latched[i]))
+        {
+            latched[i] = state;
+        }
+        frame.buttons[i] = latched[i];
+        frame.repeats[i] = repeatTotal[i];
+    }
+    sequence = next;
+}
+
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+void Panel<MaxEncoders, MaxButtons>::handleAcknowledge()
+{
+    uint8_t ack = acknowledged;
+    if (ack == lastAcknowledged)
+    {
+        return;
+    }
+    lastAcknowledged = ack;
+
+    // keep events published after the acknowledged frame only
+    uint8_t newer = sequence - ack;
+    for (uint8_t i = 0; i < buttonCount; ++i)
+    {
+        if (isEvent(latched[i]) && (static_cast<uint8_t>(latchedSequence[i] - ack - 1) >= newer))
+        {
+            latched[i] = Button::Open;
+        }
+    }
+}
+
+template <uint8_t MaxEncoders, uint8_t MaxButtons>
+void Panel<MaxEncoders, MaxButtons>::snapshot(Frame &frame)
+{
+    int32_t steps[MaxEncoders];
+    uint8_t repeats[MaxButtons];
+    uint8_t seq;
+    do
+    {
+        seq = sequence;
+        volatile Published &copy = published[seq & 1];
+        for (uint8_t i = 0; i < encoderCount; ++i)
+        {
+            steps[i] = copy.steps[i];
+        }
+        for (uint8_t i = 0; i < buttonCount; ++i)
+        {
+            frame.buttons[i] = static_cast<Button::eButtonStates>(copy.buttons[i]);
+            repeats[i] = copy.repeats[i];
+        }
+        // one publish in between wrote the other buffer. More than that: copy again.
+    } while (static_cast<uint8_t>(sequence - seq) > 1);
+
+    frame.sequence = seq;
+    for (uint8_t i = 0; i < encoderCount; ++i)
+    {
+        int32_t accumulate = steps[i] / encoders[i]->stepsPerNotch;
+        frame.increments[i] = static_cast<int16_t>(static_cast<uint32_t>(accumulate) - static_cast<uint32_t>(lastAccumulate[i]));
+        lastAccumulate[i] = accumulate;
+    }
+    for (uint8_t i = 0; i < buttonCount; ++i)
+    {
+        frame.repeats[i] = repeats[i] - lastRepeatTotal[i];
+        lastRepeatTotal[i] = repeats[i];
+    }
+    acknowledged = seq;
+}
+
+#endif // CLICKENCODERPANEL_H
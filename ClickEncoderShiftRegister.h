@@ -0,0 +1,47 @@
+// ----------------------------------------------------------------------------
+// Shift register chain input source for ClickEncoder
+// Clocks a chain of parallel-in shift registers (74HC165 style) in one SPI
+// burst per service call and fans the packed bits out to all attached
+// Encoder and Button instances, for panels with dozens of inputs.
+// ----------------------------------------------------------------------------
+
+#ifndef CLICKENCODERSHIFTREGISTER_H
+#define CLICKENCODERSHIFTREGISTER_H
+
+#include "ClickEncoderInput.h"
+
+// SPI bus with the chain's parallel load line, e.g. hardware SPI with SH/LD on a port pin.
+class SpiBus
+{
+public:
+    virtual ~SpiBus() = default;
+
+    // Pulses the parallel load line so the registers capture their inputs
+    virtual void latch() = 0;
+    // Clocks length bytes in, the first byte coming from the register closest to MISO
+    virtual void transfer(uint8_t *buffer, uint8_t length) = 0;
+};
+
+// ChainLength: number of 8 bit registers, MaxChannels: Encoder or Button instances
+template <uint8_t ChainLength, uint8_t MaxChannels = ChainLength * 4>
+class ShiftRegisterInput : public InputSource
+{
+public:
+    explicit ShiftRegisterInput(SpiBus &bus) : InputSource(channelTable, MaxChannels, ChainLength * 8),
+                                               bus(bus){};
+
+    // call this every 1 millisecond via timer ISR
+    void service() override
+    {
+        bus.latch();
+        bus.transfer(snapshot, ChainLength);
+        fanOut(snapshot);
+    };
+
+private:
+    Channel channelTable[MaxChannels]{};
+    SpiBus &bus;
+    uint8_t snapshot[ChainLength]{};
+};
+
+#endif // CLICKENCODERSHIFTREGISTER_H
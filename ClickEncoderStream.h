@@ -0,0 +1,197 @@
+// ----------------------------------------------------------------------------
+// Compact binary panel stream for ClickEncoder
+// Packs what changed since the last frame into a few bytes for slow links,
+// e.g. from Panel::Frame. The decoder is plain C++ and runs on the host too.
+//
+// Frame layout, instances numbered encoders first, then buttons:
+// - bitmap, one bit per instance (LSB first), set if it changed
+// - zigzag varint increment of every changed encoder
+// - 3 bit eButtonStates code of every changed button, LSB first, padded to a byte
+// A button is changed if its state differs from what the receiver shows while
+// nothing is sent: Closed after Closed, else Open.
+// ----------------------------------------------------------------------------
+
+#ifndef CLICKENCODERSTREAM_H
+#define CLICKENCODERSTREAM_H
+
+#include "ClickEncoder.h"
+
+namespace PanelStream
+{
+// Button state the receiver sees while no change is sent, after last was sent.
+// Events are reported once by getButton() and fall back to Open.
+inline uint8_t unchangedState(uint8_t last)
+{
+    return (last == Button::Closed) ? Button::Closed : Button::Open;
+}
+
+inline uint16_t zigzag(int16_t value)
+{
+    return (static_cast<uint16_t>(value) << 1) ^ static_cast<uint16_t>(-static_cast<int16_t>(value < 0));
+}
+
+inline int16_t unzigzag(uint16_t value)
+{
+    return static_cast<int16_t>((value >> 1) ^ static_cast<uint16_t>(-static_cast<int16_t>(value & 1)));
+}
+} // namespace PanelStream
+
+template <uint8_t Encoders, uint8_t Buttons>
+class PanelStreamEncoder
+{
+public:
+    static constexpr uint8_t BITMAP_SIZE = (Encoders + Buttons + 7) / 8;
+    // int16_t needs up to 3 varint bytes
+    static constexpr uint16_t MAX_FRAME_SIZE = BITMAP_SIZE + 3 * Encoders + (3 * Buttons + 7) / 8;
+
+    // Encoders without increment and buttons in their unchanged state are left out.
+    // out: MAX_FRAME_SIZE bytes. Returns length of the frame.
+    uint16_t encode(const int16_t *increments, const Button::eButtonStates *buttons, uint8_t *out);
+
+private:
+    // last state sent per button
+    uint8_t last[Buttons]{};
+};
+
+template <uint8_t Encoders, uint8_t Buttons>
+class PanelStreamDecoder
+{
+public:
+    // Returns number of bytes taken from in, 0 if the frame is incomplete.
+    // Unchanged encoders get 0, unchanged buttons Open or Closed as last seen.
+    uint16_t decode(const uint8_t *in, uint16_t length, int16_t *increments, Button::eButtonStates *buttons);
+
+private:
+    // last state received per button
+    uint8_t last[Buttons]{};
+};
+
+// ----------------------------------------------------------------------------
+
+template <uint8_t Encoders, uint8_t Buttons>
+uint16_t PanelStreamEncoder<Encoders, Buttons>::encode(const int16_t *increments,
+                                                       const Button::eButtonStates *buttons,
+                                                       uint8_t *out)
+{
+    for (uint8_t i = 0; i < BITMAP_SIZE; ++i)
+    {
+        out[i] = 0;
+    }
+    uint16_t length = BITMAP_SIZE;
+
+    for (uint8_t i = 0; i < Encoders; ++i)
+    {
+        if (increments[i] == 0)
+        {
+            continue;
+        }
+        out[i >> 3] |= (1 << (i & 7));
+        uint16_t value = PanelStream::zigzag(increments[i]);
+        while (value > 0x7F)
+        {
+            out[length++] = 0x80 | (value & 0x7F);
+            value >>= 7;
+        }
+        out[length++] = value;
+    }
+
+    uint8_t bits{0};
+    uint16_t packed{0};
+    for (uint8_t i = 0; i < Buttons; ++i)
+    {
+        if (buttons[i] == PanelStream::unchangedState(last[i]))
+        {
+            continue;
+        }
+        last[i] = buttons[i];
+        uint8_t instance = Encoders + i;
+        out[instance >> 3] |= (1 << (instance & 7));
+
+        packed |= static_cast<uint16_t>(buttons[i]) << bits;
+        bits += 3;
+        if (bits >= 8)
+        {
+            out[length++] = packed;
+            packed >>= 8;
+            bits -= 8;
+        }
+    }
+    if (bits)
+    {
+        out[length++] = packed;
+    }
+    return length;
+}
+
+template <uint8_t Encoders, uint8_t Buttons>
+uint16_t PanelStreamDecoder<Encoders, Buttons>::decode(const uint8_t *in,
+                                                       uint16_t length,
+                                                       int16_t *increments,
+                                                       Button::eButtonStates *buttons)
+{
+    constexpr uint8_t BITMAP_SIZE = PanelStreamEncoder<Encoders, Buttons>::BITMAP_SIZE;
+    if (length < BITMAP_SIZE)
+    {
+        return 0;
+    }
+    uint16_t position = BITMAP_SIZE;
+
+    for (uint8_t i = 0; i < Encoders; ++i)
+    {
+        increments[i] = 0;
+        if (!((in[i >> 3] >> (i & 7)) & 1))
+        {
+            continue;
+        }
+        uint16_t value{0};
+        uint8_t shift{0};
+        uint8_t byte;
+        do
+        {
+            if ((position >= length) || (shift > 14))
+            {
+                return 0;
+            }
+            byte = in[position++];
+            value |= static_cast<uint16_t>(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        increments[i] = PanelStream::unzigzag(value);
+    }
+
+    // check the button codes are complete before changing any state
+    uint8_t changedButtons{0};
+    for (uint8_t instance = Encoders; instance < Encoders + Buttons; ++instance)
+    {
+        changedButtons += (in[instance >> 3] >> (instance & 7)) & 1;
+    }
+    if ((position + ((3 * changedButtons + 7) / 8)) > length)
+    {
+        return 0;
+    }
+
+    uint8_t bits{0};
+    uint16_t packed{0};
+    for (uint8_t i = 0; i < Buttons; ++i)
+    {
+        uint8_t instance = Encoders + i;
+        if (!((in[instance >> 3] >> (instance & 7)) & 1))
+        {
+            buttons[i] = static_cast<Button::eButtonStates>(PanelStream::unchangedState(last[i]));
+            continue;
+        }
+        if (bits < 3)
+        {
+            packed |= static_cast<uint16_t>(in[position++]) << bits;
+            bits += 8;
+        }
+        uint8_t state = packed & 0x07;
+        packed >>= 3;
+        bits -= 3;
+        buttons[i] = static_cast<Button::eButtonStates>(state);
+        last[i] = state;
+    }
+    return position;
+}
+
+#endif // CLICKENCODERSTREAM_H
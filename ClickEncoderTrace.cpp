@@ -0,0 +1,107 @@
+// ----------------------------------------------------------------------------
+// Raw input trace recorder for ClickEncoder
+// ----------------------------------------------------------------------------
+
+#include "ClickEncoderTrace.h"
+
+// ----------------------------------------------------------------------------
+
+TraceRecorder::TraceRecorder(uint8_t *buffer, uint16_t size) : buffer(buffer), size(size)
+{
+    restart();
+}
+
+void TraceRecorder::restart()
+{
+    frozen = true;
+    head = 0;
+    used = 0;
+    lastTransitionTicks = ticks;
+    // no valid level: first sample of every channel is recorded
+    for (uint8_t i = 0; i < TRACE_MAX_CHANNELS; ++i)
+    {
+        lastLevels[i] = 0xFF;
+    }
+    frozen = false;
+}
+
+void TraceRecorder::handleTransition(uint8_t channel, uint8_t levels)
+{
+    lastLevels[channel] = levels;
+    if (frozen)
+    {
+        return;
+    }
+
+    write(0x80 | (channel << 3) | (levels & 0x07));
+    uint32_t delta = ticks - lastTransitionTicks;
+    lastTransitionTicks = ticks;
+    while (delta > 0x3F)
+    {
+        write(0x40 | (delta & 0x3F));
+        delta >>= 6;
+    }
+    write(delta);
+}
+
+void TraceRecorder::write(uint8_t data)
+{
+    // overwrite oldest: the history right before a fault is what counts
+    buffer[head] = data;
+    head = (head + 1 < size) ? head + 1 : 0;
+    if (used < size)
+    {
+        ++used;
+    }
+}
+
+uint16_t TraceRecorder::read(uint8_t *out, uint16_t maxLength)
+{
+    // head and used are only stable once record() stopped writing
+    if (!frozen)
+    {
+        return 0;
+    }
+    uint16_t count = (used < maxLength) ? used : maxLength;
+    uint16_t tail = (head >= used) ? head - used : head + size - used;
+    for (uint16_t i = 0; i < count; ++i)
+    {
+        out[i] = buffer[tail];
+        tail = (tail + 1 < size) ? tail + 1 : 0;
+    }
+    used -= count;
+    return count;
+}
+
+uint16_t TraceRecorder::decode(const uint8_t *in, uint16_t length, Transition &transition)
+{
+    uint16_t position{0};
+    while (position < length)
+    {
+        // resynchronize at the next header
+        if (!(in[position] & 0x80))
+        {
+            ++position;
+            continue;
+        }
+
+        transition.channel = (in[position] >> 3) & 0x0F;
+        transition.levels = in[position] & 0x07;
+        transition.ticks = 0;
+        ++position;
+        for (uint8_t shift = 0; (position < length) && !(in[position] & 0x80); shift += 6)
+        {
+            uint8_t data = in[position++];
+            if (shift < 32)
+            {
+                transition.ticks |= static_cast<uint32_t>(data & 0x3F) << shift;
+            }
+            if (!(data & 0x40))
+            {
+                return position;
+            }
+        }
+        // delta cut off by a header: start over there. By the end of input: incomplete.
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+// ----------------------------------------------------------------------------
+// Raw input trace recorder for ClickEncoder
+// Records pin level transitions of Encoder and Button instances with tick
+// deltas into a RAM ring buffer, to be frozen and read out after a fault.
+//
+// Format, a few bytes per transition:
+// - header byte 0x80 | channel << 3 | levels (encoder: bit0 A, bit1 B; button: bit0)
+// - ticks since the previous transition, 6 bits per byte, LSB first, at least one byte.
+//   Bit 6 is set if another delta byte follows.
+// Only headers have bit 7 set, so a reader can start anywhere in the stream.
+// ----------------------------------------------------------------------------
+
+#ifndef CLICKENCODERTRACE_H
+#define CLICKENCODERTRACE_H
+
+#include "ClickEncoder.h"
+
+class TraceRecorder
+{
+public:
+    struct Transition
+    {
+        uint8_t channel;
+        uint8_t levels;
+        uint32_t ticks;
+    };
+
+    // buffer: ring buffer memory, owned by the caller
+    TraceRecorder(uint8_t *buffer, uint16_t size);
+    TraceRecorder(const TraceRecorder &cpyRecorder) = delete;
+    TraceRecorder &operator=(const TraceRecorder &srcRecorder) = delete;
+
+    // call once per ::service() period, before servicing the instances
+    void tick() { ++ticks; };
+    // called by instances on every sample, costs a compare if nothing changed
+    void record(uint8_t channel, uint8_t levels)
+    {
+        if (levels != lastLevels[channel])
+        {
+            handleTransition(channel, levels);
+        }
+    };
+
+    // stops recording, e.g. when a fault is detected, to keep the history for read()
+    void freeze() { frozen = true; };
+    // clears the buffer and records again
+    void restart();
+    // Copies recorded bytes, oldest first. Returns number of bytes, 0 when all read.
+    // Only after freeze(): returns 0 while ::service() may still record.
+    uint16_t read(uint8_t *out, uint16_t maxLength);
+
+    // Parses one transition from recorded bytes, skipping partial ones at the start.
+    // Returns bytes taken, 0 if no complete transition is left (e.g. its delta continues in the next read()).
+    static uint16_t decode(const uint8_t *in, uint16_t length, Transition &transition);
+
+private:
+    void handleTransition(uint8_t channel, uint8_t levels);
+    void write(uint8_t data);
+
+    uint8_t *const buffer;
+    const uint16_t size;
+    uint16_t head{0};
+    uint16_t used{0};
+    uint32_t ticks{0};
+    uint32_t lastTransitionTicks{0};
+    volatile bool frozen{false};
+    uint8_t lastLevels[TRACE_MAX_CHANNELS];
+};
+
+#endif // CLICKENCODERTRACE_H
@@ -0,0 +1,98 @@
+#include <ClickEncoder.h>
+#include <ClickEncoderAwait.h>
+
+#include "benchmark_main.h"
+
+#ifdef __cpp_impl_coroutine
+
+#include <stdio.h>
+
+constexpr uint8_t PIN_ENCA{4};
+constexpr uint8_t PIN_ENCB{5};
+constexpr uint8_t PIN_BTN{3};
+// main loop polling the instances every x ticks, e.g. a 60Hz UI loop
+constexpr uint8_t POLL_INTERVAL{16};
+// release edge at tick 107 of 400, between two button samples
+constexpr uint16_t CLICK_PERIOD{400};
+constexpr uint16_t CLICK_RELEASE{107};
+
+static uint32_t currentTick{0};
+static uint32_t latencySum{0};
+static uint32_t latencyCount{0};
+static int32_t turned{0};
+
+static void simulateInput(uint32_t tick)
+{
+    currentTick = tick;
+    simulateTurn(PIN_ENCA, PIN_ENCB, tick, 7);
+    hostPinLevels()[PIN_BTN] = ((tick % CLICK_PERIOD) < CLICK_RELEASE) ? LOW : HIGH;
+}
+
+static void recordClick()
+{
+    latencySum += (currentTick - CLICK_RELEASE) % CLICK_PERIOD;
+    ++latencyCount;
+}
+
+static void printLatency(const char *name)
+{
+    printf("%-48s %8.1f ticks from release edge\n", name,
+           latencyCount ? static_cast<double>(latencySum) / latencyCount : 0.0);
+    latencySum = 0;
+    latencyCount = 0;
+}
+
+static InputTask clickHandler(InputEvents &events)
+{
+    for (;;)
+    {
+        Button::eButtonStates state = co_await events.nextButtonEvent();
+        if (state == Button::Clicked)
+        {
+            recordClick();
+        }
+    }
+}
+
+static InputTask turnHandler(InputEvents &events)
+{
+    for (;;)
+    {
+        turned += co_await events.nextRotation();
+    }
+}
+
+void benchmark_inputEvents_awaitVsPolling()
+{
+    static Encoder pollEncoder{PIN_ENCA, PIN_ENCB};
+    static Button pollButton{PIN_BTN};
+    runBenchmark("Encoder + Button polled every 16 ticks", [](uint32_t tick) {
+        simulateInput(tick);
+        pollEncoder.service();
+        pollButton.service();
+        if ((tick % POLL_INTERVAL) == 0)
+        {
+            turned += pollEncoder.getIncrement();
+            if (pollButton.getButton() == Button::Clicked)
+            {
+                recordClick();
+            }
+        }
+    });
+    printLatency("Clicked latency, polled every 16 ticks");
+
+    static Encoder awaitEncoder{PIN_ENCA, PIN_ENCB};
+    static Button awaitButton{PIN_BTN};
+    static InputEvents events{&awaitEncoder, &awaitButton};
+    clickHandler(events);
+    turnHandler(events);
+    runBenchmark("Encoder + Button awaited (InputEvents)", [](uint32_t tick) {
+        simulateInput(tick);
+        awaitEncoder.service();
+        awaitButton.service();
+        events.service();
+    });
+    printLatency("Clicked latency, awaited");
+}
+
+#endif // __cpp_impl_coroutine
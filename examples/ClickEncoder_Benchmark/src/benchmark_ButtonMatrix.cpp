@@ -0,0 +1,28 @@
+#include <ClickEncoder.h>
+#include <ClickEncoderMatrix.h>
+
+#include "benchmark_main.h"
+
+static uint8_t selectedRow{0};
+static uint32_t matrixTick{0};
+
+static void selectRow(uint8_t row)
+{
+    selectedRow = row;
+}
+
+static uint16_t readColumns()
+{
+    // a few keys of every row clicking, active low
+    return ((matrixTick % 400) < 100) ? static_cast<uint16_t>(~(0x81 >> (selectedRow & 1))) : 0xFFFF;
+}
+
+void benchmark_buttonMatrix_service8x8()
+{
+    static ButtonMatrix<8, 8> matrix{selectRow, readColumns};
+    matrix.setDoubleClickEnabled(true);
+    runBenchmark("ButtonMatrix<8, 8>::service() 64 keys", [](uint32_t tick) {
+        matrixTick = tick;
+        matrix.service();
+    });
+}
@@ -0,0 +1,107 @@
+#include <ClickEncoder.h>
+#include <ClickEncoderTrace.h>
+
+#include "benchmark_main.h"
+
+constexpr uint8_t PIN_ENCA{4};
+constexpr uint8_t PIN_ENCB{5};
+constexpr uint8_t PIN_BTN{3};
+// a spike on the encoder lines every x ticks
+constexpr uint8_t SPIKE_INTERVAL{37};
+
+static void simulateNoisyTurn(uint32_t tick)
+{
+    simulateTurn(PIN_ENCA, PIN_ENCB, tick, 3);
+    if ((tick % SPIKE_INTERVAL) == 0)
+    {
+        hostPinLevels()[PIN_ENCB] ^= HIGH;
+    }
+}
+
+static void simulateClicks(uint32_t tick)
+{
+    // 100ms pressed, 300ms released
+    hostPinLevels()[PIN_BTN] = ((tick % 400) < 100) ? LOW : HIGH;
+}
+
+void benchmark_encoder_service()
+{
+    static Encoder encoder{PIN_ENCA, PIN_ENCB};
+    runBenchmark("Encoder::service()", [](uint32_t tick) {
+        simulateNoisyTurn(tick);
+        encoder.service();
+    });
+}
+
+void benchmark_encoder_service_inputFilter()
+{
+    static Encoder encoder3{PIN_ENCA, PIN_ENCB};
+    encoder3.setInputFilter(3, 2);
+    runBenchmark("Encoder::service() InputFilter 2 of 3", [](uint32_t tick) {
+        simulateNoisyTurn(tick);
+        encoder3.service();
+    });
+
+    static Encoder encoder8{PIN_ENCA, PIN_ENCB};
+    encoder8.setInputFilter(8, 5);
+    runBenchmark("Encoder::service() InputFilter 5 of 8", [](uint32_t tick) {
+        simulateNoisyTurn(tick);
+        encoder8.service();
+    });
+}
+
+void benchmark_button_service()
+{
+    static Button button{PIN_BTN};
+    runBenchmark("Button::service()", [](uint32_t tick) {
+        simulateClicks(tick);
+        button.service();
+    });
+}
+
+void benchmark_button_service_inputFilter()
+{
+    static Button button{PIN_BTN};
+    button.setInputFilter(3, 2);
+    runBenchmark("Button::service() InputFilter 2 of 3", [](uint32_t tick) {
+        simulateClicks(tick);
+        button.service();
+    });
+}
+
+void benchmark_clickEncoder_service()
+{
+    static ClickEncoder clickEncoder{PIN_ENCA, PIN_ENCB, PIN_BTN};
+    clickEncoder.setAccelerationEnabled(true);
+    clickEncoder.setDoubleClickEnabled(true);
+    runBenchmark("ClickEncoder::service()", [](uint32_t tick) {
+        simulateNoisyTurn(tick);
+        simulateClicks(tick);
+        clickEncoder.service();
+    });
+}
+
+void benchmark_clickEncoder_service_gestures()
+{
+    static ClickEncoder clickEncoderG{PIN_ENCA, PIN_ENCB, PIN_BTN};
+    clickEncoderG.setGesturesEnabled(true);
+    runBenchmark("ClickEncoder::service() gestures", [](uint32_t tick) {
+        simulateNoisyTurn(tick);
+        simulateClicks(tick);
+        clickEncoderG.service();
+        clickEncoderG.getGesture();
+    });
+}
+
+void benchmark_encoder_service_traceRecorder()
+{
+    static uint8_t traceBuffer[256];
+    static TraceRecorder recorder{traceBuffer, sizeof(traceBuffer)};
+    static Encoder encoderT{PIN_ENCA, PIN_ENCB};
+    encoderT.setTraceRecorder(&recorder, 0);
+    runBenchmark("Encoder::service() TraceRecorder", [](uint32_t tick) {
+        simulateNoisyTurn(tick);
+        recorder.tick();
+        encoderT.service();
+    });
+}
@@ -0,0 +1,42 @@
+#include <ClickEncoder.h>
+#include <ClickEncoderPanel.h>
+
+#include "benchmark_main.h"
+
+constexpr uint8_t PANEL_CONTROLS{12};
+// a snapshot of the whole panel every x ticks
+constexpr uint8_t SNAPSHOT_INTERVAL{10};
+
+static Panel<PANEL_CONTROLS, PANEL_CONTROLS> panel;
+
+static void setupPanel()
+{
+    // pins 0..23 encoders, 24..35 buttons
+    for (uint8_t i = 0; i < PANEL_CONTROLS; ++i)
+    {
+        Encoder *encoder = new Encoder(2 * i, 2 * i + 1);
+        encoder->setAccelerationEnabled(true);
+        Button *button = new Button(2 * PANEL_CONTROLS + i);
+        button->setDoubleClickEnabled(true);
+        panel.add(*encoder);
+        panel.add(*button);
+    }
+}
+
+void benchmark_panel_service12x12()
+{
+    setupPanel();
+    runBenchmark("Panel<12, 12>::service() + snapshot", [](uint32_t tick) {
+        static Panel<PANEL_CONTROLS, PANEL_CONTROLS>::Frame frame;
+        for (uint8_t i = 0; i < PANEL_CONTROLS; ++i)
+        {
+            simulateTurn(2 * i, 2 * i + 1, tick + i, 3 + i);
+            hostPinLevels()[2 * PANEL_CONTROLS + i] = (((tick + 50 * i) % 400) < 100) ? LOW : HIGH;
+        }
+        panel.service();
+        if ((tick % SNAPSHOT_INTERVAL) == 0)
+        {
+            panel.snapshot(frame);
+        }
+    });
+}
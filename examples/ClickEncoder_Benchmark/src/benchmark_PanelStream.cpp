@@ -0,0 +1,55 @@
+#include <stdio.h>
+
+#include <ClickEncoder.h>
+#include <ClickEncoderStream.h>
+
+#include "benchmark_main.h"
+
+constexpr uint8_t STREAM_ENCODERS{16};
+constexpr uint8_t STREAM_BUTTONS{16};
+// 115200 baud, 8N1: bytes per 1ms frame
+constexpr float UART_BYTES_PER_MS{115200.0f / 10 / 1000};
+
+typedef PanelStreamEncoder<STREAM_ENCODERS, STREAM_BUTTONS> StreamEncoder;
+typedef PanelStreamDecoder<STREAM_ENCODERS, STREAM_BUTTONS> StreamDecoder;
+
+static uint32_t streamBytes{0};
+
+static uint32_t nextRandom()
+{
+    static uint32_t state{12345};
+    state = state * 1103515245 + 12345;
+    return state >> 8;
+}
+
+void benchmark_panelStream_encodeDecode32Controls()
+{
+    runBenchmark("PanelStream encode + decode 32 controls", [](uint32_t tick) {
+        static StreamEncoder encoder;
+        static StreamDecoder decoder;
+        static int16_t increments[STREAM_ENCODERS];
+        static Button::eButtonStates buttons[STREAM_BUTTONS];
+        static uint8_t frame[StreamEncoder::MAX_FRAME_SIZE];
+        static int16_t decodedIncrements[STREAM_ENCODERS];
+        static Button::eButtonStates decodedButtons[STREAM_BUTTONS];
+
+        // a few encoders turning fast, buttons pressed now and then
+        for (uint8_t i = 0; i < STREAM_ENCODERS; ++i)
+        {
+            uint32_t r = nextRandom();
+            increments[i] = ((r & 0x0F) < 3) ? static_cast<int16_t>((r >> 4) % 11) - 5 : 0;
+        }
+        for (uint8_t i = 0; i < STREAM_BUTTONS; ++i)
+        {
+            uint32_t r = nextRandom();
+            buttons[i] = ((r & 0xFF) == 0) ? static_cast<Button::eButtonStates>((r >> 8) % 7) : Button::Open;
+        }
+
+        uint16_t length = encoder.encode(increments, buttons, frame);
+        decoder.decode(frame, length, decodedIncrements, decodedButtons);
+        streamBytes += length;
+        (void)tick;
+    });
+    printf("%-48s %8.1f bytes/frame (UART budget %.1f)\n", "PanelStream 32 controls",
+           static_cast<double>(streamBytes) / BENCHMARK_TICKS, UART_BYTES_PER_MS);
+}
@@ -0,0 +1,59 @@
+#include <ClickEncoder.h>
+#include <ClickEncoderShiftRegister.h>
+
+#include "benchmark_main.h"
+
+constexpr uint8_t CHAIN_LENGTH{8};
+constexpr uint8_t ENCODERS{16};
+constexpr uint8_t BUTTONS{32};
+
+// Budget on the target: ATmega328P at 16 MHz servicing the chain from the 1 ms timer ISR
+// may use half of the tick, 8000 cycles for 8 registers and 48 instances.
+// This 32 bit integer code runs at least 100 times faster on the host than on the AVR,
+// so the host has 1/100 of the target time.
+constexpr uint16_t TARGET_BUDGET_CYCLES{8000};
+constexpr uint8_t TARGET_CLOCK_MHZ{16};
+constexpr uint8_t HOST_SPEEDUP{100};
+
+// Fake SPI: simulates all encoders turning and all buttons clicking
+class FakeSpi : public SpiBus
+{
+public:
+    void latch() override { ++tick; };
+
+    void transfer(uint8_t *buffer, uint8_t length) override
+    {
+        // GrayCode sequence 00 -> 01 -> 11 -> 10 for all encoder pairs
+        static const uint8_t QUADRATURE[4]{0x00, 0x55, 0xFF, 0xAA};
+        uint8_t encoderBits = QUADRATURE[(tick / 3) & 3];
+        uint8_t buttonBits = ((tick % 400) < 100) ? 0x00 : 0xFF;
+        for (uint8_t i = 0; i < length; ++i)
+        {
+            buffer[i] = (i < (ENCODERS * 2 / 8)) ? encoderBits : buttonBits;
+        }
+    };
+
+private:
+    uint32_t tick{0};
+};
+
+static FakeSpi spi;
+static ShiftRegisterInput<CHAIN_LENGTH, ENCODERS + BUTTONS> chain{spi};
+
+void benchmark_shiftRegisterInput_service64Inputs()
+{
+    for (uint8_t i = 0; i < ENCODERS; ++i)
+    {
+        chain.attach(*new Encoder{SAMPLED_ELSEWHERE}, i * 2, i * 2 + 1);
+    }
+    for (uint8_t i = 0; i < BUTTONS; ++i)
+    {
+        chain.attach(*new Button{SAMPLED_ELSEWHERE}, ENCODERS * 2 + i);
+    }
+
+    double nsPerTick = runBenchmark("ShiftRegisterInput::service() 64 inputs", [](uint32_t) {
+        chain.service();
+    });
+    checkBudget("ShiftRegisterInput, ATmega328P half tick", nsPerTick,
+                (TARGET_BUDGET_CYCLES * 1000.0) / TARGET_CLOCK_MHZ / HOST_SPEEDUP);
+}
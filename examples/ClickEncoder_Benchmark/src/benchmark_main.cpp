@@ -0,0 +1,69 @@
+#include <chrono>
+#include <stdio.h>
+
+#include <ClickEncoder.h>
+
+#include "benchmark_main.h"
+
+static uint8_t budgetMisses{0};
+
+double runBenchmark(const char *name, void (*serviceTick)(uint32_t tick))
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t tick = 0; tick < BENCHMARK_TICKS; ++tick)
+    {
+        serviceTick(tick);
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(stop - start).count();
+    printf("%-48s %8.1f ns/tick\n", name, nanoseconds / BENCHMARK_TICKS);
+    return nanoseconds / BENCHMARK_TICKS;
+}
+
+void checkBudget(const char *name, double nsPerTick, double budgetNs)
+{
+    bool within = (nsPerTick <= budgetNs);
+    printf("%-48s %8.1f ns/tick budget, %s\n", name, budgetNs, within ? "ok" : "EXCEEDED");
+    if (!within)
+    {
+        ++budgetMisses;
+    }
+}
+
+void simulateTurn(uint8_t pinA, uint8_t pinB, uint32_t tick, uint8_t stepTicks)
+{
+    // GrayCode sequence 00 -> 01 -> 11 -> 10
+    static const uint8_t LEVELS_A[4]{LOW, LOW, HIGH, HIGH};
+    static const uint8_t LEVELS_B[4]{LOW, HIGH, HIGH, LOW};
+    uint8_t step = (tick / stepTicks) & 3;
+    hostPinLevels()[pinA] = LEVELS_A[step];
+    hostPinLevels()[pinB] = LEVELS_B[step];
+}
+
+int main()
+{
+    // Input benchmarks
+    benchmark_encoder_service();
+    benchmark_encoder_service_inputFilter();
+    benchmark_encoder_service_traceRecorder();
+    benchmark_button_service();
+    benchmark_button_service_inputFilter();
+    benchmark_clickEncoder_service();
+    benchmark_clickEncoder_service_gestures();
+
+    // Input source benchmarks
+    benchmark_shiftRegisterInput_service64Inputs();
+    benchmark_buttonMatrix_service8x8();
+
+    // Panel benchmarks
+    benchmark_panel_service12x12();
+    benchmark_panelStream_encodeDecode32Controls();
+
+#ifdef __cpp_impl_coroutine
+    // Awaitable event benchmarks
+    benchmark_inputEvents_awaitVsPolling();
+#endif
+
+    return (budgetMisses > 0) ? 1 : 0;
+}
@@ -0,0 +1,40 @@
+#ifndef BENCHMARK_MAIN_H
+#define BENCHMARK_MAIN_H
+
+#include <stdint.h>
+
+// simulated ::service() calls per benchmark
+constexpr uint32_t BENCHMARK_TICKS = 2000000;
+
+// Calls serviceTick for BENCHMARK_TICKS simulated ticks, prints and returns time per tick in ns
+double runBenchmark(const char *name, void (*serviceTick)(uint32_t tick));
+
+// Prints whether nsPerTick is within budgetNs. Misses fail the benchmark run.
+void checkBudget(const char *name, double nsPerTick, double budgetNs);
+
+// Sets simulated encoder pins to a quadrature sequence, one step every stepTicks
+void simulateTurn(uint8_t pinA, uint8_t pinB, uint32_t tick, uint8_t stepTicks);
+
+// all function prototypes of all benchmarks shall be placed here
+
+// INPUT
+void benchmark_encoder_service();
+void benchmark_encoder_service_inputFilter();
+void benchmark_encoder_service_traceRecorder();
+void benchmark_button_service();
+void benchmark_button_service_inputFilter();
+void benchmark_clickEncoder_service();
+void benchmark_clickEncoder_service_gestures();
+// SHIFTREGISTER
+void benchmark_shiftRegisterInput_service64Inputs();
+// BUTTONMATRIX
+void benchmark_buttonMatrix_service8x8();
+// PANEL
+void benchmark_panel_service12x12();
+void benchmark_panelStream_encodeDecode32Controls();
+#ifdef __cpp_impl_coroutine
+// AWAIT
+void benchmark_inputEvents_awaitVsPolling();
+#endif
+
+#endif // BENCHMARK_MAIN_H
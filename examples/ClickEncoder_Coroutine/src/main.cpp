@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <unistd.h>
+
+#include <ClickEncoder.h>
+#include <ClickEncoderAwait.h>
+#include <ClickEncoderLinux.h>
+
+// gpiochip and line offsets of the board
+constexpr const char *GPIO_CHIP = "/dev/gpiochip0";
+constexpr uint32_t LINE_ENCA = 17;
+constexpr uint32_t LINE_ENCB = 18;
+constexpr uint32_t LINE_BTN = 27;
+constexpr uint8_t ENC_STEPSPERNOTCH = 4;
+constexpr bool BTN_ACTIVESTATE = LOW;
+// notches to turn for the next page
+constexpr uint16_t PAGE_NOTCHES = 5;
+
+// pins are not read by the library on Linux, events feed the instances
+static Encoder exampleEncoder{SAMPLED_ELSEWHERE, ENC_STEPSPERNOTCH, BTN_ACTIVESTATE};
+static Button exampleButton{SAMPLED_ELSEWHERE, BTN_ACTIVESTATE};
+static InputEvents events{&exampleEncoder, &exampleButton};
+
+// --- forward-declared function prototypes:
+// Adjusts a volume on every notch
+InputTask volumeHandler();
+// Turns pages every PAGE_NOTCHES notches
+InputTask pageHandler();
+// Prints button events, mutes on DoubleClick
+InputTask buttonHandler();
+
+static int16_t volume{50};
+static bool muted{false};
+
+int main()
+{
+    const uint32_t lines[]{LINE_ENCA, LINE_ENCB, LINE_BTN};
+    int lineFd = GpioEventSource::requestLines(GPIO_CHIP, lines, 3);
+    if (lineFd < 0)
+    {
+        perror("Requesting GPIO lines failed");
+        return 1;
+    }
+
+    GpioEventSource source{lineFd};
+    source.attach(exampleEncoder, LINE_ENCA, LINE_ENCB);
+    source.attach(exampleButton, LINE_BTN);
+    // lines rest at whatever the knob was left at, start decoding from there
+    if (!source.readLevels(lines, 3))
+    {
+        perror("Reading GPIO line levels failed");
+        return 1;
+    }
+    exampleButton.setDoubleClickEnabled(true);
+
+    printf("Hi! This is the ClickEncoder Coroutine Example Program.\n");
+
+    // each handler runs until its first co_await
+    volumeHandler();
+    pageHandler();
+    buttonHandler();
+
+    // Single-threaded executor: handlers resume from events.service(),
+    // in this thread, right after the instances saw the events.
+    while (source.dispatch(InputActivity::isIdle() ? -1 : ENC_BUTTONINTERVAL) >= 0)
+    {
+        // let timeouts (Held, DoubleClick) elapse even without line events
+        source.service();
+        events.service();
+    }
+
+    close(lineFd);
+    return 0;
+}
+
+InputTask volumeHandler()
+{
+    for (;;)
+    {
+        int16_t notches = co_await events.nextRotation();
+        volume += notches;
+        volume = (volume < 0) ? 0 : (volume > 100) ? 100 : volume;
+        printf("Volume: %d%s\n", volume, muted ? " (muted)" : "");
+    }
+}
+
+InputTask pageHandler()
+{
+    int16_t page = 0;
+    for (;;)
+    {
+        int16_t notches = co_await events.nextRotation(PAGE_NOTCHES);
+        page += (notches > 0) ? 1 : -1;
+        printf("Page: %d\n", page);
+    }
+}
+
+InputTask buttonHandler()
+{
+    for (;;)
+    {
+        Button::eButtonStates state = co_await events.nextButtonEvent();
+        switch (state)
+        {
+        case Button::Clicked:
+            printf("Button clicked\n");
+            break;
+        case Button::DoubleClicked:
+            muted = !muted;
+            printf("Button doubleClicked, %s\n", muted ? "muted" : "unmuted");
+            break;
+        case Button::Held:
+            printf("Button Held\n");
+            break;
+        case Button::Released:
+            printf("Button released\n");
+            break;
+        default:
+            break;
+        }
+    }
+}
@@ -0,0 +1,268 @@
+// ----------------------------------------------------------------------------
+// Reference model: a frozen copy of the Encoder and Button decode and debounce
+// logic. Optimized implementations are compared against it, so leave it as is
+// when optimizing. Only change it when the library's behavior is meant to change.
+// ----------------------------------------------------------------------------
+
+#include "fuzz_main.h"
+
+namespace
+{
+class ReferenceEncoder
+{
+public:
+    explicit ReferenceEncoder(const StreamConfig &config)
+        : stepsPerNotch(config.stepsPerNotch),
+          accelerationEnabled(config.accelerationEnabled),
+          skipRecoveryEnabled(config.skipRecoveryEnabled){};
+
+    void service(bool levelA, bool levelB)
+    {
+        handleElapsedTick();
+        // GrayCode convert: 00 -> 0, 01 -> 1, 11 -> 2, 10 -> 3
+        uint8_t encoderRead = levelA ? 3 : 0;
+        handleEncoder(encoderRead ^ levelB);
+    };
+
+    int32_t getPosition() const
+    {
+        if ((stepsPerNotch & (stepsPerNotch - 1)) == 0)
+        {
+            uint8_t shift = 8;
+            for (uint8_t steps = stepsPerNotch; steps > 1; steps >>= 1)
+            {
+                --shift;
+            }
+            return static_cast<int32_t>(static_cast<uint32_t>(encoderAccumulate) << shift);
+        }
+        return (encoderAccumulate * 256) / stepsPerNotch;
+    };
+    uint16_t getInferredSteps() const { return inferredSteps; };
+
+private:
+    void handleElapsedTick()
+    {
+        if (lastDirectionAge < ENC_SKIPRECOVERY_TIMEOUT)
+        {
+            ++lastDirectionAge;
+        }
+        if (lastMovedCount < ENC_ACCEL_START)
+        {
+            ++lastMovedCount;
+        }
+    };
+
+    void handleEncoder(uint8_t encoderRead)
+    {
+        uint8_t rawMovement = encoderRead - lastEncoderRead;
+        lastEncoderRead = encoderRead;
+        int8_t signedMovement = ((rawMovement & 1) - (rawMovement & 2));
+        signedMovement = handleSkippedState(rawMovement, signedMovement);
+
+        encoderAccumulate += signedMovement;
+        encoderAccumulate += handleAcceleration(signedMovement);
+    };
+
+    int8_t handleSkippedState(uint8_t rawMovement, int8_t signedMovement)
+    {
+        if ((rawMovement & 3) != 2)
+        {
+            if (signedMovement != 0)
+            {
+                lastDirection = signedMovement;
+                lastDirectionAge = 0;
+            }
+            return signedMovement;
+        }
+        if (!skipRecoveryEnabled || (lastDirectionAge >= ENC_SKIPRECOVERY_TIMEOUT))
+        {
+            return signedMovement;
+        }
+        ++inferredSteps;
+        lastDirectionAge = 0;
+        return (lastDirection > 0) ? 2 : -2;
+    };
+
+    int8_t handleAcceleration(int8_t direction)
+    {
+        if (direction == 0 || !accelerationEnabled || (encoderAccumulate % stepsPerNotch))
+        {
+            return 0;
+        }
+        int16_t acceleration = ((ENC_ACCEL_START / ENC_ACCEL_SLOPE) - (lastMovedCount / ENC_ACCEL_SLOPE));
+        lastMovedCount = 0;
+        return (direction > 0) ? acceleration : -acceleration;
+    };
+
+    const uint8_t stepsPerNotch;
+    const bool accelerationEnabled;
+    const bool skipRecoveryEnabled;
+    uint8_t lastEncoderRead{0};
+    int32_t encoderAccumulate{0};
+    uint8_t lastMovedCount{ENC_ACCEL_START};
+    int8_t lastDirection{0};
+    uint8_t lastDirectionAge{ENC_SKIPRECOVERY_TIMEOUT};
+    uint16_t inferredSteps{0};
+};
+
+class ReferenceButton
+{
+public:
+    explicit ReferenceButton(const StreamConfig &config)
+        : doubleClickEnabled(config.doubleClickEnabled),
+          longPressRepeatEnabled(config.longPressRepeatEnabled)
+    {
+        uint16_t startInterval = (config.repeatStartInterval > UINT8_MAX * ENC_BUTTONINTERVAL)
+                                     ? UINT8_MAX * ENC_BUTTONINTERVAL
+                                     : config.repeatStartInterval;
+        uint16_t minInterval = (config.repeatMinInterval > startInterval) ? startInterval : config.repeatMinInterval;
+        startTicks = startInterval / ENC_BUTTONINTERVAL;
+        minTicks = minInterval / ENC_BUTTONINTERVAL;
+        stepTicks = (startTicks - minTicks) / (config.repeatRampSteps ? config.repeatRampSteps : 1);
+        if ((stepTicks == 0) && (startTicks > minTicks))
+        {
+            stepTicks = 1;
+        }
+    };
+
+    // level: active low
+    void service(bool level)
+    {
+        ++lastGetButtonCount;
+        if (lastGetButtonCount < ENC_BUTTONINTERVAL)
+        {
+            return;
+        }
+        lastGetButtonCount = 0;
+        if (level == LOW)
+        {
+            handlePressed();
+        }
+        else
+        {
+            handleReleased();
+        }
+        if (doubleClickTicks > 0)
+        {
+            --doubleClickTicks;
+        }
+    };
+
+    Button::eButtonStates getButton()
+    {
+        Button::eButtonStates result{buttonState};
+        if (result == Button::LongPressRepeat)
+        {
+            lastRepeatCount = repeatCount;
+            repeatCount = 0;
+        }
+        if (buttonState != Button::Closed)
+        {
+            buttonState = Button::Open;
+        }
+        return result;
+    };
+    bool isPressed() const { return keyDownTicks > 0; };
+    uint8_t getLongPressRepeatCount() const { return lastRepeatCount; };
+
+private:
+    void handlePressed()
+    {
+        if (keyDownTicks < (ENC_HOLDTIME / ENC_BUTTONINTERVAL))
+        {
+            buttonState = Button::Closed;
+            ++keyDownTicks;
+            if (keyDownTicks < (ENC_HOLDTIME / ENC_BUTTONINTERVAL))
+            {
+                return;
+            }
+            buttonState = Button::Held;
+            repeatTicks = 0;
+            repeatInterval = startTicks;
+            return;
+        }
+
+        if (!longPressRepeatEnabled)
+        {
+            return;
+        }
+        if (++repeatTicks >= repeatInterval)
+        {
+            repeatTicks = 0;
+            if (repeatCount < UINT8_MAX)
+            {
+                ++repeatCount;
+            }
+            repeatInterval = (repeatInterval > (minTicks + stepTicks)) ? repeatInterval - stepTicks : minTicks;
+            buttonState = Button::LongPressRepeat;
+        }
+    };
+
+    void handleReleased()
+    {
+        uint16_t downTicks = keyDownTicks;
+        keyDownTicks = 0;
+        if (downTicks >= (ENC_HOLDTIME / ENC_BUTTONINTERVAL))
+        {
+            buttonState = Button::Released;
+        }
+        else if (downTicks > 0)
+        {
+            buttonState = Button::Clicked;
+            if (!doubleClickEnabled)
+            {
+                return;
+            }
+            if (doubleClickTicks == 0)
+            {
+                doubleClickTicks = (ENC_DOUBLECLICKTIME / ENC_BUTTONINTERVAL);
+            }
+            else
+            {
+                buttonState = Button::DoubleClicked;
+                doubleClickTicks = 0;
+            }
+        }
+    };
+
+    const bool doubleClickEnabled;
+    const bool longPressRepeatEnabled;
+    uint8_t startTicks;
+    uint8_t minTicks;
+    uint8_t stepTicks;
+    Button::eButtonStates buttonState{Button::Open};
+    uint8_t doubleClickTicks{0};
+    uint16_t keyDownTicks{0};
+    uint8_t repeatTicks{0};
+    uint8_t repeatInterval{0};
+    uint8_t repeatCount{0};
+    uint8_t lastRepeatCount{0};
+    uint16_t lastGetButtonCount{ENC_BUTTONINTERVAL};
+};
+
+class ReferenceModel : public Model
+{
+public:
+    explicit ReferenceModel(const StreamConfig &config) : encoder(config), button(config){};
+
+    void tick(uint8_t sample) override
+    {
+        encoder.service(sample & SAMPLE_A, sample & SAMPLE_B);
+        button.service(sample & SAMPLE_BTN);
+    };
+    int32_t getPosition() override { return encoder.getPosition(); };
+    uint16_t getInferredSteps() override { return encoder.getInferredSteps(); };
+    bool isPressed() override { return button.isPressed(); };
+    Button::eButtonStates getButton() override { return button.getButton(); };
+    uint8_t getLongPressRepeatCount() override { return button.getLongPressRepeatCount(); };
+
+private:
+    ReferenceEncoder encoder;
+    ReferenceButton button;
+};
+} // namespace
+
+Model *createReferenceModel(const StreamConfig &config)
+{
+    return new ReferenceModel(config);
+}
@@ -0,0 +1,220 @@
+// ----------------------------------------------------------------------------
+// Random and adversarial pin-sample streams
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+
+#include "fuzz_main.h"
+
+namespace
+{
+// GrayCode sequence 00 -> 01 -> 11 -> 10, as samples
+constexpr uint8_t QUADRATURE[4]{0, SAMPLE_B, SAMPLE_A | SAMPLE_B, SAMPLE_A};
+
+enum eSegments : uint8_t
+{
+    Idle = 0,
+    Turn,
+    FastSpin,
+    Glitches,
+    Press,
+    Noise,
+    Segments
+};
+
+class StreamWriter
+{
+public:
+    StreamWriter(uint32_t seed, uint8_t *samples) : state(seed ? seed : 1), samples(samples){};
+
+    // xorshift32
+    uint32_t random()
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    };
+    // lowest..highest, both included
+    uint32_t random(uint32_t lowest, uint32_t highest) { return lowest + (random() % (highest - lowest + 1)); };
+    bool chance(uint8_t percent) { return (random() % 100) < percent; };
+
+    bool isFull() const { return length >= FUZZ_MAX_TICKS; };
+    uint32_t getLength() const { return length; };
+
+    void hold(uint32_t ticks)
+    {
+        for (; ticks && !isFull(); --ticks)
+        {
+            samples[length++] = current();
+        }
+    };
+    // toggles lines a few times before they settle, on every edge
+    void bounce(uint8_t lines, uint8_t maxBounces)
+    {
+        for (uint8_t i = random(0, maxBounces); i && !isFull(); --i)
+        {
+            samples[length++] = current() ^ lines;
+            hold(random(0, 2));
+        }
+    };
+    void step(int8_t direction, bool withBounce)
+    {
+        uint8_t last = current();
+        code = (code + direction) & 3;
+        if (withBounce)
+        {
+            bounce(last ^ current(), 4);
+        }
+    };
+    void setPressed(bool pressed, bool withBounce)
+    {
+        if (withBounce)
+        {
+            bounce(SAMPLE_BTN, 6);
+        }
+        buttonLevel = pressed ? 0 : SAMPLE_BTN;
+    };
+    void noise() { samples[length++] = random() & (SAMPLE_A | SAMPLE_B | SAMPLE_BTN); };
+
+private:
+    uint8_t current() const { return QUADRATURE[code] | buttonLevel; };
+
+    uint32_t state;
+    uint8_t *const samples;
+    uint32_t length{0};
+    uint8_t code{0};
+    uint8_t buttonLevel{SAMPLE_BTN};
+};
+
+void writeTurn(StreamWriter &writer)
+{
+    int8_t direction = writer.chance(50) ? 1 : -1;
+    uint32_t ticksPerStep = writer.random(1, 30);
+    bool withBounce = writer.chance(50);
+    for (uint32_t steps = writer.random(1, 40); steps && !writer.isFull(); --steps)
+    {
+        writer.step(direction, withBounce);
+        writer.hold(ticksPerStep);
+        // occasional reversal
+        if (writer.chance(3))
+        {
+            direction = -direction;
+        }
+    }
+}
+
+void writeFastSpin(StreamWriter &writer)
+{
+    int8_t direction = writer.chance(50) ? 1 : -1;
+    uint8_t skipChance = writer.random(0, 30);
+    for (uint32_t steps = writer.random(10, 400); steps && !writer.isFull(); --steps)
+    {
+        writer.step(direction, false);
+        // sampled too slowly: a state in between is skipped
+        if (writer.chance(skipChance))
+        {
+            writer.step(direction, false);
+        }
+        writer.hold(writer.random(1, 2));
+    }
+}
+
+void writeGlitches(StreamWriter &writer)
+{
+    static const uint8_t LINES[3]{SAMPLE_A, SAMPLE_B, SAMPLE_BTN};
+    for (uint32_t glitches = writer.random(1, 20); glitches && !writer.isFull(); --glitches)
+    {
+        writer.bounce(LINES[writer.random(0, 2)], 1);
+        writer.hold(writer.random(0, 60));
+    }
+}
+
+void writePress(StreamWriter &writer)
+{
+    bool withBounce = writer.chance(70);
+    writer.setPressed(true, withBounce);
+    // short clicks, double clicks, Held and long LongPressRepeat series
+    uint32_t heldTicks = writer.chance(60) ? writer.random(1, 300) : writer.random(300, 4000);
+    if (writer.chance(20))
+    {
+        writer.hold(heldTicks / 2);
+        writeTurn(writer);
+        writer.hold(heldTicks / 2);
+    }
+    else
+    {
+        writer.hold(heldTicks);
+    }
+    writer.setPressed(false, withBounce);
+    writer.hold(writer.random(1, 500));
+}
+} // namespace
+
+uint32_t generateStream(uint32_t seed, StreamConfig &config, uint8_t *samples)
+{
+    StreamWriter writer{seed, samples};
+
+    static const uint8_t STEPS_PER_NOTCH[4]{1, 2, 3, 4};
+    config.stepsPerNotch = STEPS_PER_NOTCH[writer.random(0, 3)];
+    config.accelerationEnabled = writer.chance(50);
+    config.skipRecoveryEnabled = writer.chance(50);
+    config.doubleClickEnabled = writer.chance(50);
+    config.longPressRepeatEnabled = writer.chance(50);
+    config.repeatStartInterval = writer.random(0, 600);
+    config.repeatMinInterval = writer.random(0, 600);
+    config.repeatRampSteps = writer.random(0, 8);
+    config.pollInterval = writer.chance(30) ? 1 : writer.random(2, 50);
+
+    uint32_t length = writer.random(FUZZ_MAX_TICKS / 10, FUZZ_MAX_TICKS);
+    while (writer.getLength() < length)
+    {
+        switch (writer.random(0, Segments - 1))
+        {
+        case Idle:
+            writer.hold(writer.random(1, 500));
+            break;
+        case Turn:
+            writeTurn(writer);
+            break;
+        case FastSpin:
+            writeFastSpin(writer);
+            break;
+        case Glitches:
+            writeGlitches(writer);
+            break;
+        case Press:
+            writePress(writer);
+            break;
+        default:
+            for (uint32_t ticks = writer.random(1, 200); ticks && !writer.isFull(); --ticks)
+            {
+                writer.noise();
+            }
+            break;
+        }
+    }
+    return writer.getLength();
+}
+
+void printStream(const StreamConfig &config, const uint8_t *samples, uint32_t length)
+{
+    printf("  stepsPerNotch %u, acceleration %u, skipRecovery %u, doubleClick %u, longPressRepeat %u\n",
+           config.stepsPerNotch, config.accelerationEnabled, config.skipRecoveryEnabled,
+           config.doubleClickEnabled, config.longPressRepeatEnabled);
+    printf("  repeatRamp %u..%u ms in %u steps, getButton() every %u ticks\n",
+           config.repeatStartInterval, config.repeatMinInterval, config.repeatRampSteps, config.pollInterval);
+    printf("  tick    A B BTN  ticks\n");
+    uint32_t runStart = 0;
+    for (uint32_t tick = 1; tick <= length; ++tick)
+    {
+        if ((tick < length) && (samples[tick] == samples[runStart]))
+        {
+            continue;
+        }
+        uint8_t sample = samples[runStart];
+        printf("  %6u  %u %u %u    x %u\n", runStart, (sample & SAMPLE_A) ? 1 : 0, (sample & SAMPLE_B) ? 1 : 0,
+               (sample & SAMPLE_BTN) ? 1 : 0, tick - runStart);
+        runStart = tick;
+    }
+}
@@ -0,0 +1,251 @@
+// ----------------------------------------------------------------------------
+// Implementation paths compared against the reference model.
+// Add a variant here for every new decode, debounce or fan-out path.
+// ----------------------------------------------------------------------------
+
+#include <ClickEncoder.h>
+#include <ClickEncoderMatrix.h>
+#include <ClickEncoderShiftRegister.h>
+#include <ClickEncoderTrace.h>
+
+#include "fuzz_main.h"
+
+namespace
+{
+constexpr uint8_t PIN_ENCA{4};
+constexpr uint8_t PIN_ENCB{5};
+constexpr uint8_t PIN_BTN{3};
+constexpr uint16_t TRACE_SIZE{64};
+
+void setPins(uint8_t sample)
+{
+    hostPinLevels()[PIN_ENCA] = (sample & SAMPLE_A) ? HIGH : LOW;
+    hostPinLevels()[PIN_ENCB] = (sample & SAMPLE_B) ? HIGH : LOW;
+    hostPinLevels()[PIN_BTN] = (sample & SAMPLE_BTN) ? HIGH : LOW;
+}
+
+bool always(const StreamConfig &)
+{
+    return true;
+}
+
+// Library Encoder and Button, configured like the stream says
+class LibraryModel : public Model
+{
+public:
+    explicit LibraryModel(const StreamConfig &config)
+        : encoder(PIN_ENCA, PIN_ENCB, config.stepsPerNotch), button(PIN_BTN)
+    {
+        encoder.setAccelerationEnabled(config.accelerationEnabled);
+        encoder.setSkipRecoveryEnabled(config.skipRecoveryEnabled);
+        button.setDoubleClickEnabled(config.doubleClickEnabled);
+        button.setLongPressRepeatEnabled(config.longPressRepeatEnabled);
+        button.setLongPressRepeatRamp(config.repeatStartInterval, config.repeatMinInterval, config.repeatRampSteps);
+    };
+
+    int32_t getPosition() override { return encoder.getPosition(); };
+    uint16_t getInferredSteps() override { return encoder.getInferredSteps(); };
+    bool isPressed() override { return button.isPressed(); };
+    Button::eButtonStates getButton() override { return button.getButton(); };
+    uint8_t getLongPressRepeatCount() override { return button.getLongPressRepeatCount(); };
+
+protected:
+    Encoder encoder;
+    Button button;
+};
+
+// ::service() reading the pins, as called from a timer ISR
+class PinModel : public LibraryModel
+{
+public:
+    explicit PinModel(const StreamConfig &config) : LibraryModel(config){};
+
+    void tick(uint8_t sample) override
+    {
+        setPins(sample);
+        encoder.service();
+        button.service();
+    };
+};
+
+// ::service(levels) with pins sampled elsewhere
+class LevelModel : public LibraryModel
+{
+public:
+    explicit LevelModel(const StreamConfig &config) : LibraryModel(config){};
+
+    void tick(uint8_t sample) override
+    {
+        encoder.service(sample & SAMPLE_A, sample & SAMPLE_B);
+        button.service(sample & SAMPLE_BTN);
+    };
+};
+
+// K-of-N filter configured to pass every sample
+class FilterDepth1Model : public PinModel
+{
+public:
+    explicit FilterDepth1Model(const StreamConfig &config) : PinModel(config)
+    {
+        encoder.setInputFilter(1, 1);
+        button.setInputFilter(1, 1);
+    };
+};
+
+// Recording must not change what the instances report
+class TraceModel : public PinModel
+{
+public:
+    explicit TraceModel(const StreamConfig &config) : PinModel(config), recorder(traceBuffer, TRACE_SIZE)
+    {
+        encoder.setTraceRecorder(&recorder, 0);
+        button.setTraceRecorder(&recorder, 1);
+    };
+
+    void tick(uint8_t sample) override
+    {
+        recorder.tick();
+        PinModel::tick(sample);
+    };
+
+private:
+    uint8_t traceBuffer[TRACE_SIZE];
+    TraceRecorder recorder;
+};
+
+// Edge events decoded by ::update(), ticks by ::service(levels).
+// Decodes edges before the tick's time base advances, so only equivalent
+// without the time dependent features.
+class UpdateModel : public LevelModel
+{
+public:
+    explicit UpdateModel(const StreamConfig &config) : LevelModel(config){};
+
+    void tick(uint8_t sample) override
+    {
+        uint8_t changed = (sample ^ lastSample) & (SAMPLE_A | SAMPLE_B);
+        lastSample = sample;
+        if (changed)
+        {
+            encoder.update(sample & SAMPLE_A, sample & SAMPLE_B);
+        }
+        LevelModel::tick(sample);
+    };
+
+private:
+    uint8_t lastSample{0};
+};
+
+bool withoutTimeBase(const StreamConfig &config)
+{
+    return !config.accelerationEnabled && !config.skipRecoveryEnabled;
+}
+
+// Whole stream sample as a one byte shift register chain
+class SampleSpi : public SpiBus
+{
+public:
+    void latch() override{};
+    void transfer(uint8_t *buffer, uint8_t) override { buffer[0] = sample; };
+
+    uint8_t sample{0};
+};
+
+class ShiftRegisterModel : public LibraryModel
+{
+public:
+    explicit ShiftRegisterModel(const StreamConfig &config) : LibraryModel(config), chain(spi)
+    {
+        chain.attach(encoder, 0, 1);
+        chain.attach(button, 2);
+    };
+
+    void tick(uint8_t sample) override
+    {
+        spi.sample = sample;
+        chain.service();
+    };
+
+private:
+    SampleSpi spi;
+    ShiftRegisterInput<1, 2> chain;
+};
+
+// A matrix key sampled like a Button, the other row's key stays released
+uint8_t matrixColumns{0};
+uint8_t selectedMatrixRow{0};
+
+void selectMatrixRow(uint8_t row)
+{
+    selectedMatrixRow = row;
+}
+
+uint16_t readMatrixColumns()
+{
+    return (selectedMatrixRow == 0) ? matrixColumns : 1;
+}
+
+class MatrixKeyModel : public LevelModel
+{
+public:
+    explicit MatrixKeyModel(const StreamConfig &config)
+        : LevelModel(config), matrix(selectMatrixRow, readMatrixColumns)
+    {
+        matrix.setDoubleClickEnabled(config.doubleClickEnabled);
+        matrix.setLongPressRepeatEnabled(config.longPressRepeatEnabled);
+        matrix.setLongPressRepeatRamp(config.repeatStartInterval, config.repeatMinInterval, config.repeatRampSteps);
+        // first call only selects the row: scan the key on the same ticks as a Button
+        matrix.service();
+    };
+
+    void tick(uint8_t sample) override
+    {
+        matrixColumns = (sample & SAMPLE_BTN) ? 1 : 0;
+        matrix.service();
+    };
+    bool isPressed() override { return matrix.isPressed(0, 0); };
+    Button::eButtonStates getButton() override { return matrix.getButton(0, 0); };
+    uint8_t getLongPressRepeatCount() override { return matrix.getLongPressRepeatCount(0, 0); };
+
+private:
+    ButtonMatrix<2, 1> matrix;
+};
+
+// Forgets the ::service() time base: skipped states are always recovered
+class BrokenTimeBaseModel : public LevelModel
+{
+public:
+    explicit BrokenTimeBaseModel(const StreamConfig &config) : LevelModel(config){};
+
+    void tick(uint8_t sample) override
+    {
+        encoder.update(sample & SAMPLE_A, sample & SAMPLE_B);
+        button.service(sample & SAMPLE_BTN);
+    };
+};
+
+bool withSkipRecovery(const StreamConfig &config)
+{
+    return config.skipRecoveryEnabled;
+}
+
+template <typename M>
+Model *create(const StreamConfig &config)
+{
+    return new M(config);
+}
+} // namespace
+
+const Variant VARIANTS[]{
+    {"Encoder/Button::service()", OBSERVE_ENCODER | OBSERVE_BUTTON, always, create<PinModel>},
+    {"Encoder/Button::service(levels)", OBSERVE_ENCODER | OBSERVE_BUTTON, always, create<LevelModel>},
+    {"InputFilter depth 1", OBSERVE_ENCODER | OBSERVE_BUTTON, always, create<FilterDepth1Model>},
+    {"TraceRecorder attached", OBSERVE_ENCODER | OBSERVE_BUTTON, always, create<TraceModel>},
+    {"Encoder::update() on edges", OBSERVE_ENCODER | OBSERVE_BUTTON, withoutTimeBase, create<UpdateModel>},
+    {"ShiftRegisterInput fan-out", OBSERVE_ENCODER | OBSERVE_BUTTON, always, create<ShiftRegisterModel>},
+    {"ButtonMatrix<2, 1> key", OBSERVE_BUTTON, always, create<MatrixKeyModel>},
+    {nullptr, 0, nullptr, nullptr},
+};
+
+const Variant SELFTEST_VARIANT{"Encoder::update() without time base", OBSERVE_ENCODER, withSkipRecovery,
+                               create<BrokenTimeBaseModel>};
@@ -0,0 +1,279 @@
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ClickEncoder.h>
+
+#include "fuzz_main.h"
+
+constexpr uint8_t MAX_VARIANTS = 16;
+constexpr uint32_t DEFAULT_STREAMS = 500;
+
+static uint8_t streamSamples[FUZZ_MAX_TICKS];
+static uint8_t shrunkSamples[FUZZ_MAX_TICKS];
+static uint8_t candidateSamples[FUZZ_MAX_TICKS];
+
+// State of a model after one tick
+struct Observation
+{
+    int32_t position;
+    uint16_t inferredSteps;
+    bool pressed;
+    Button::eButtonStates button;
+    uint8_t repeatCount;
+};
+
+// --- forward-declared function prototypes:
+// Reads a model's state. getButton() resets it, so it is only read when polled.
+void observe(Model &model, bool poll, Observation &observation);
+// Compares what the variant observes. Returns true if equal.
+bool compare(const Observation &expected, const Observation &actual, uint8_t observes, bool poll,
+             Divergence &divergence);
+// Runs one variant in lockstep with the reference. Returns true on divergence.
+bool findDivergence(const Variant &variant, const StreamConfig &config, const uint8_t *samples, uint32_t length,
+                    Divergence &divergence);
+// Removes and flattens samples as long as the variant still diverges. Returns shrunk length.
+uint32_t shrink(const Variant &variant, const StreamConfig &config, uint8_t *samples, uint32_t length);
+// Shrinks and prints a divergence
+void report(const Variant &variant, const StreamConfig &config, uint32_t seed, const Divergence &divergence);
+
+// Usage: fuzz [streams [seed]] [--selftest]
+int main(int argc, char **argv)
+{
+    uint32_t streams{DEFAULT_STREAMS};
+    uint32_t seed{1};
+    bool selftest{false};
+    uint8_t numbers{0};
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--selftest") == 0)
+        {
+            selftest = true;
+        }
+        else if (numbers++ == 0)
+        {
+            streams = strtoul(argv[i], nullptr, 10);
+        }
+        else
+        {
+            seed = strtoul(argv[i], nullptr, 10);
+        }
+    }
+
+    const Variant *variants[MAX_VARIANTS];
+    uint8_t variantCount{0};
+    if (selftest)
+    {
+        variants[variantCount++] = &SELFTEST_VARIANT;
+    }
+    else
+    {
+        for (const Variant *variant = VARIANTS; variant->name && (variantCount < MAX_VARIANTS); ++variant)
+        {
+            variants[variantCount++] = variant;
+        }
+    }
+
+    printf("Hi! This is the ClickEncoder differential fuzzer: %u streams from seed %u.\n", streams, seed);
+
+    uint32_t comparedStreams[MAX_VARIANTS]{};
+    uint64_t comparedTicks[MAX_VARIANTS]{};
+    bool diverged[MAX_VARIANTS]{};
+    uint64_t modelTicks{0};
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t stream = 0; stream < streams; ++stream)
+    {
+        StreamConfig config;
+        uint32_t streamSeed = seed + stream;
+        uint32_t length = generateStream(streamSeed, config, streamSamples);
+
+        // all variants run in lockstep with one reference
+        Model *reference = createReferenceModel(config);
+        Model *models[MAX_VARIANTS]{};
+        for (uint8_t v = 0; v < variantCount; ++v)
+        {
+            if (!diverged[v] && variants[v]->supports(config))
+            {
+                models[v] = variants[v]->create(config);
+                ++comparedStreams[v];
+            }
+        }
+
+        for (uint32_t tick = 0; tick < length; ++tick)
+        {
+            uint8_t sample = streamSamples[tick];
+            bool poll = ((tick % config.pollInterval) == (config.pollInterval - 1U));
+            Observation expected;
+            reference->tick(sample);
+            observe(*reference, poll, expected);
+            ++modelTicks;
+            for (uint8_t v = 0; v < variantCount; ++v)
+            {
+                if (!models[v])
+                {
+                    continue;
+                }
+                Observation actual;
+                Divergence divergence{tick, nullptr, 0, 0};
+                models[v]->tick(sample);
+                observe(*models[v], poll, actual);
+                ++modelTicks;
+                ++comparedTicks[v];
+                if (!compare(expected, actual, variants[v]->observes, poll, divergence))
+                {
+                    diverged[v] = true;
+                    delete models[v];
+                    models[v] = nullptr;
+                    report(*variants[v], config, streamSeed, divergence);
+                }
+            }
+        }
+
+        delete reference;
+        for (uint8_t v = 0; v < variantCount; ++v)
+        {
+            delete models[v];
+        }
+    }
+
+    auto stop = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(stop - start).count();
+
+    bool anyDiverged{false};
+    for (uint8_t v = 0; v < variantCount; ++v)
+    {
+        printf("%-40s %6u streams %12llu ticks  %s\n", variants[v]->name, comparedStreams[v],
+               static_cast<unsigned long long>(comparedTicks[v]), diverged[v] ? "DIVERGED" : "ok");
+        anyDiverged |= diverged[v];
+    }
+    printf("%.1f million model ticks per second\n", modelTicks / seconds / 1e6);
+
+    // self test passes if the broken variant was caught
+    return (anyDiverged != selftest) ? 1 : 0;
+}
+
+void observe(Model &model, bool poll, Observation &observation)
+{
+    observation.position = model.getPosition();
+    observation.inferredSteps = model.getInferredSteps();
+    observation.pressed = model.isPressed();
+    observation.button = poll ? model.getButton() : Button::Open;
+    observation.repeatCount = model.getLongPressRepeatCount();
+}
+
+bool compare(const Observation &expected, const Observation &actual, uint8_t observes, bool poll,
+             Divergence &divergence)
+{
+    struct Check
+    {
+        const char *what;
+        uint8_t observes;
+        int32_t expected;
+        int32_t actual;
+    };
+    const Check checks[]{
+        {"getPosition()", OBSERVE_ENCODER, expected.position, actual.position},
+        {"getInferredSteps()", OBSERVE_ENCODER, expected.inferredSteps, actual.inferredSteps},
+        {"isPressed()", OBSERVE_BUTTON, expected.pressed, actual.pressed},
+        {"getButton()", static_cast<uint8_t>(poll ? OBSERVE_BUTTON : 0), expected.button, actual.button},
+        {"getLongPressRepeatCount()", OBSERVE_BUTTON, expected.repeatCount, actual.repeatCount},
+    };
+    // first differing value wins, in order of the checks
+    for (const Check &check : checks)
+    {
+        if ((check.observes & observes) && (check.expected != check.actual))
+        {
+            divergence.what = check.what;
+            divergence.expected = check.expected;
+            divergence.actual = check.actual;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool findDivergence(const Variant &variant, const StreamConfig &config, const uint8_t *samples, uint32_t length,
+                    Divergence &divergence)
+{
+    Model *reference = createReferenceModel(config);
+    Model *model = variant.create(config);
+    bool found{false};
+    for (uint32_t tick = 0; (tick < length) && !found; ++tick)
+    {
+        bool poll = ((tick % config.pollInterval) == (config.pollInterval - 1U));
+        Observation expected;
+        Observation actual;
+        reference->tick(samples[tick]);
+        model->tick(samples[tick]);
+        observe(*reference, poll, expected);
+        observe(*model, poll, actual);
+        divergence.tick = tick;
+        found = !compare(expected, actual, variant.observes, poll, divergence);
+    }
+    delete reference;
+    delete model;
+    return found;
+}
+
+uint32_t shrink(const Variant &variant, const StreamConfig &config, uint8_t *samples, uint32_t length)
+{
+    Divergence divergence;
+    uint32_t trials{0};
+
+    // remove chunks of samples, halving the chunk size once none can be removed
+    for (uint32_t chunk = length / 2; (chunk > 0) && (trials < FUZZ_SHRINK_TRIALS); chunk /= 2)
+    {
+        uint32_t start{0};
+        while ((start + chunk <= length) && (trials++ < FUZZ_SHRINK_TRIALS))
+        {
+            memcpy(candidateSamples, samples, start);
+            memcpy(candidateSamples + start, samples + start + chunk, length - start - chunk);
+            if (findDivergence(variant, config, candidateSamples, length - chunk, divergence))
+            {
+                // nothing after the divergence matters
+                length = divergence.tick + 1;
+                memcpy(samples, candidateSamples, length);
+            }
+            else
+            {
+                start += chunk;
+            }
+        }
+    }
+
+    // flatten remaining edges and glitches: repeat the previous sample instead
+    for (uint32_t tick = 1; (tick < length) && (trials++ < FUZZ_SHRINK_TRIALS); ++tick)
+    {
+        if (samples[tick] == samples[tick - 1])
+        {
+            continue;
+        }
+        memcpy(candidateSamples, samples, length);
+        candidateSamples[tick] = samples[tick - 1];
+        if (findDivergence(variant, config, candidateSamples, length, divergence))
+        {
+            length = divergence.tick + 1;
+            memcpy(samples, candidateSamples, length);
+        }
+    }
+    return length;
+}
+
+void report(const Variant &variant, const StreamConfig &config, uint32_t seed, const Divergence &divergence)
+{
+    printf("\n%s diverged in stream seed %u at tick %u: %s expected %d, got %d\n", variant.name, seed,
+           divergence.tick, divergence.what, divergence.expected, divergence.actual);
+
+    uint32_t length = divergence.tick + 1;
+    memcpy(shrunkSamples, streamSamples, length);
+    length = shrink(variant, config, shrunkSamples, length);
+
+    Divergence shrunk{0, nullptr, 0, 0};
+    findDivergence(variant, config, shrunkSamples, length, shrunk);
+    printf("Shrunk to %u ticks, diverging at tick %u: %s expected %d, got %d\n", length, shrunk.tick, shrunk.what,
+           shrunk.expected, shrunk.actual);
+    printStream(config, shrunkSamples, length);
+    printf("\n");
+}
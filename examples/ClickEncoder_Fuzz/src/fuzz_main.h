@@ -0,0 +1,85 @@
+#ifndef FUZZ_MAIN_H
+#define FUZZ_MAIN_H
+
+#include <stdint.h>
+
+#include <ClickEncoder.h>
+
+// longest generated stream, in ::service() ticks
+constexpr uint32_t FUZZ_MAX_TICKS = 20000;
+// re-runs allowed to shrink one divergence
+constexpr uint32_t FUZZ_SHRINK_TRIALS = 20000;
+
+// One sample per tick: bit0 level A, bit1 level B, bit2 level BTN (active low)
+constexpr uint8_t SAMPLE_A = 0x01;
+constexpr uint8_t SAMPLE_B = 0x02;
+constexpr uint8_t SAMPLE_BTN = 0x04;
+
+// Configuration of one stream, applied to the reference and all variants alike
+struct StreamConfig
+{
+    uint8_t stepsPerNotch;
+    bool accelerationEnabled;
+    bool skipRecoveryEnabled;
+    bool doubleClickEnabled;
+    bool longPressRepeatEnabled;
+    uint16_t repeatStartInterval;
+    uint16_t repeatMinInterval;
+    uint8_t repeatRampSteps;
+    // getButton() is read every x ticks, like a main loop would
+    uint8_t pollInterval;
+};
+
+// What models expose to be compared
+constexpr uint8_t OBSERVE_ENCODER = 0x01;
+constexpr uint8_t OBSERVE_BUTTON = 0x02;
+
+// Common interface of the reference model and the variants under test
+class Model
+{
+public:
+    virtual ~Model() = default;
+
+    virtual void tick(uint8_t sample) = 0;
+    virtual int32_t getPosition() = 0;
+    virtual uint16_t getInferredSteps() = 0;
+    virtual bool isPressed() = 0;
+    virtual Button::eButtonStates getButton() = 0;
+    virtual uint8_t getLongPressRepeatCount() = 0;
+};
+
+// Implementation path expected to behave exactly like the reference model
+struct Variant
+{
+    const char *name;
+    uint8_t observes;
+    // false if the variant is not equivalent under this configuration
+    bool (*supports)(const StreamConfig &config);
+    Model *(*create)(const StreamConfig &config);
+};
+
+struct Divergence
+{
+    uint32_t tick;
+    const char *what;
+    int32_t expected;
+    int32_t actual;
+};
+
+// REFERENCE
+Model *createReferenceModel(const StreamConfig &config);
+
+// VARIANTS
+// all variants to be compared, terminated by an entry with name nullptr
+extern const Variant VARIANTS[];
+// deliberately broken variant, shows divergence reports and shrinking
+extern const Variant SELFTEST_VARIANT;
+
+// STREAMS
+// Fills samples with a random mix of idle time, turns with bounce, fast spins
+// with skipped states, glitches, held buttons and noise. Returns length.
+uint32_t generateStream(uint32_t seed, StreamConfig &config, uint8_t *samples);
+// Prints config and samples run-length encoded, up to length
+void printStream(const StreamConfig &config, const uint8_t *samples, uint32_t length);
+
+#endif // FUZZ_MAIN_H
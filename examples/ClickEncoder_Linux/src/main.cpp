@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <unistd.h>
+
+#include <ClickEncoder.h>
+#include <ClickEncoderLinux.h>
+
+// gpiochip and line offsets of the board
+constexpr const char *GPIO_CHIP = "/dev/gpiochip0";
+constexpr uint32_t LINE_ENCA = 17;
+constexpr uint32_t LINE_ENCB = 18;
+constexpr uint32_t LINE_BTN = 27;
+constexpr uint8_t ENC_STEPSPERNOTCH = 4;
+constexpr bool BTN_ACTIVESTATE = LOW;
+
+// pins are not read by the library on Linux, events feed the instances
+static Encoder exampleEncoder{SAMPLED_ELSEWHERE, ENC_STEPSPERNOTCH, BTN_ACTIVESTATE};
+static Button exampleButton{SAMPLED_ELSEWHERE, BTN_ACTIVESTATE};
+
+// --- forward-declared function prototypes:
+// Prints out button state
+void printButtonState();
+// Prints turn information
+void printEncoderValue();
+
+int main()
+{
+    const uint32_t lines[]{LINE_ENCA, LINE_ENCB, LINE_BTN};
+    int lineFd = GpioEventSource::requestLines(GPIO_CHIP, lines, 3);
+    if (lineFd < 0)
+    {
+        perror("Requesting GPIO lines failed");
+        return 1;
+    }
+
+    GpioEventSource source{lineFd};
+    source.attach(exampleEncoder, LINE_ENCA, LINE_ENCB);
+    source.attach(exampleButton, LINE_BTN);
+    // lines rest at whatever the knob was left at, start decoding from there
+    if (!source.readLevels(lines, 3))
+    {
+        perror("Reading GPIO line levels failed");
+        return 1;
+    }
+    exampleButton.setDoubleClickEnabled(true);
+    exampleEncoder.setAccelerationEnabled(true);
+
+    printf("Hi! This is the ClickEncoder Linux Example Program.\n");
+
+    while (source.dispatch(InputActivity::isIdle() ? -1 : ENC_BUTTONINTERVAL) >= 0)
+    {
+        // let timeouts (Held, DoubleClick) elapse even without line events
+        source.service();
+        if (!InputActivity::isPending())
+        {
+            continue;
+        }
+        // acknowledge first: changes while reading stay pending for the next round
+        InputActivity::acknowledge();
+        printButtonState();
+        printEncoderValue();
+    }
+
+    close(lineFd);
+    return 0;
+}
+
+void printButtonState()
+{
+    switch (exampleButton.getButton())
+    {
+    case Button::Clicked:
+        printf("Button clicked\n");
+        break;
+    case Button::DoubleClicked:
+        printf("Button doubleClicked\n");
+        break;
+    case Button::Held:
+        printf("Button Held\n");
+        break;
+    case Button::Released:
+        printf("Button released\n");
+        break;
+    default:
+        // no output for "Open" or "Closed" to not spam the console.
+        break;
+    }
+}
+
+void printEncoderValue()
+{
+    int16_t value = exampleEncoder.getIncrement();
+    if (value != 0)
+    {
+        printf("Encoder value: %d\n", value);
+    }
+}
@@ -0,0 +1,88 @@
+#include <ArduinoFake.h>
+#include <ClickEncoderAbsolute.h>
+
+#include <unity.h>
+
+using namespace fakeit;
+
+static uint8_t trackLevels{0};
+
+static uint8_t readTracks()
+{
+    return trackLevels;
+}
+
+static uint8_t binaryToGray(uint8_t binary)
+{
+    return binary ^ (binary >> 1);
+}
+
+// active HIGH, position given as binary
+static void serviceAt(AbsoluteEncoder<4> &enc, uint8_t position, uint8_t calls)
+{
+    for (uint8_t i = 0; i < calls; ++i)
+    {
+        enc.service(binaryToGray(position));
+    }
+}
+
+void grayCodeTable_allCodes_convertedToBinary()
+{
+    typedef AbsoluteEncoder<8>::Table Table;
+    for (uint16_t i = 0; i < 256; ++i)
+    {
+        TEST_ASSERT_EQUAL(i, Table::toBinary[binaryToGray(i)]);
+    }
+}
+
+void absoluteEncoder_firstStableRead_noIncrement()
+{
+    AbsoluteEncoder<4> enc{nullptr, HIGH};
+    serviceAt(enc, 9, ENC_ABSOLUTE_STABLETIME);
+
+    TEST_ASSERT_EQUAL(9, enc.getAbsolutePosition());
+    TEST_ASSERT_EQUAL(0, enc.getIncrement());
+    TEST_ASSERT_EQUAL(0, enc.getAccumulate());
+}
+
+void absoluteEncoder_turnBackAcrossWrap_getDecrement2()
+{
+    AbsoluteEncoder<4> enc{nullptr, HIGH};
+    serviceAt(enc, 1, ENC_ABSOLUTE_STABLETIME);
+    serviceAt(enc, 0, ENC_ABSOLUTE_STABLETIME);
+    serviceAt(enc, 15, ENC_ABSOLUTE_STABLETIME);
+
+    TEST_ASSERT_EQUAL(15, enc.getAbsolutePosition());
+    TEST_ASSERT_EQUAL(-2, enc.getIncrement());
+    TEST_ASSERT_EQUAL(0, enc.getIncrement());
+}
+
+void absoluteEncoder_glitchShorterThanStableTime_ignored()
+{
+    AbsoluteEncoder<4> enc{nullptr, HIGH};
+    serviceAt(enc, 3, ENC_ABSOLUTE_STABLETIME);
+    // 3 -> 4 changes two tracks, one switches early: reads as 7 for a moment
+    serviceAt(enc, 7, ENC_ABSOLUTE_STABLETIME - 1);
+    serviceAt(enc, 4, ENC_ABSOLUTE_STABLETIME);
+
+    TEST_ASSERT_EQUAL(1, enc.getIncrement());
+}
+
+void absoluteEncoder_activeLowPortRead_getIncrement()
+{
+    AbsoluteEncoder<4> enc{readTracks, LOW};
+    trackLevels = ~binaryToGray(2);
+    for (uint8_t i = 0; i < ENC_ABSOLUTE_STABLETIME; ++i)
+    {
+        enc.service();
+    }
+    // upper, unused bits of the port read are ignored
+    trackLevels = ~binaryToGray(5) & 0x0F;
+    for (uint8_t i = 0; i < ENC_ABSOLUTE_STABLETIME; ++i)
+    {
+        enc.service();
+    }
+
+    TEST_ASSERT_EQUAL(5, enc.getAbsolutePosition());
+    TEST_ASSERT_EQUAL(3, enc.getAccumulate());
+}
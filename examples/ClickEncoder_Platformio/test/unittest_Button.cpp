@@ -44,6 +44,21 @@ void button_constructor_activeLow_SetsInputPullup()
     Verify(Method(ArduinoFake(), pinMode).Using(buttonPin, INPUT_PULLUP)).Once();
 }
 
+void button_clickEncoderWithoutButton_service_noPinRead()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    When(Method(ArduinoFake(), digitalRead)).AlwaysReturn(HIGH);
+
+    ClickEncoder clickEnc{5, 6};
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL * 2; ++i)
+    {
+        clickEnc.service();
+    }
+
+    Verify(Method(ArduinoFake(), digitalRead).Using(ENC_NOPIN)).Never();
+    TEST_ASSERT_EQUAL(Button::Open, clickEnc.getButton());
+}
+
 void button_constructor_activeHigh_Input()
 {
     When(Method(ArduinoFake(), pinMode)).Return();
@@ -126,6 +141,19 @@ void button_click_getTwice_Open()
     button_teardown();
 }
 
+void button_heldAboveThreshold_readTwice_Open()
+{
+    button_setup();
+
+    When(Method(ArduinoFake(), digitalRead)).AlwaysReturn(buttonActiveState); // pressed
+    simulateButtonService(ENC_HOLDTIME + 1);
+    TEST_ASSERT_EQUAL(Button::Held, button->getButton());
+    simulateButtonService(ENC_BUTTONINTERVAL);
+
+    TEST_ASSERT_EQUAL(Button::Open, button->getButton());
+    button_teardown();
+}
+
 void button_heldAboveThreshold_release_Released()
 {
     button_setup();
@@ -140,6 +168,23 @@ void button_heldAboveThreshold_release_Released()
     button_teardown();
 }
 
+void button_heldRead_release_Released()
+{
+    button_setup();
+
+    When(Method(ArduinoFake(), digitalRead)).AlwaysReturn(buttonActiveState); // pressed
+    simulateButtonService(ENC_HOLDTIME + 1);
+    TEST_ASSERT_EQUAL(Button::Held, button->getButton());
+    simulateButtonService(ENC_LONGPRESSREPEATINTERVAL);
+    TEST_ASSERT_EQUAL(Button::LongPressRepeat, button->getButton());
+
+    When(Method(ArduinoFake(), digitalRead)).AlwaysReturn(!buttonActiveState); // not pressed
+    simulateButtonService(ENC_BUTTONINTERVAL);
+
+    TEST_ASSERT_EQUAL(Button::Released, button->getButton());
+    button_teardown();
+}
+
 void button_heldUntilLongPressRepeat_LongPressRepeat()
 {
     button_setup();
@@ -163,7 +208,7 @@ void button_longPressRepeatOff_heldUntilLongPressRepeat_Held()
     button_teardown();
 }
 
-void button_heldUntilLongPressRepeat_keepHeld_Held()
+void button_heldUntilLongPressRepeat_keepHeld_Open()
 {
     button_setup();
     When(Method(ArduinoFake(), digitalRead)).AlwaysReturn(buttonActiveState); // pressed
@@ -172,10 +217,54 @@ void button_heldUntilLongPressRepeat_keepHeld_Held()
     button->getButton();
     simulateButtonService(ENC_BUTTONINTERVAL);
 
-    TEST_ASSERT_EQUAL(Button::Held, button->getButton());
+    // Held and LongPressRepeat are events, reported once
+    TEST_ASSERT_EQUAL(Button::Open, button->getButton());
+    TEST_ASSERT_TRUE(button->isPressed());
+    button_teardown();
+}
+
+void button_heldUntilThreeRepeats_slowRead_repeatCount3()
+{
+    button_setup();
+    When(Method(ArduinoFake(), digitalRead)).AlwaysReturn(buttonActiveState); // pressed
+    simulateButtonService(ENC_HOLDTIME + 3 * ENC_LONGPRESSREPEATINTERVAL + 1);
+
+    TEST_ASSERT_EQUAL(Button::LongPressRepeat, button->getButton());
+    TEST_ASSERT_EQUAL(3, button->getLongPressRepeatCount());
+    button_teardown();
+}
+
+void button_longPressRepeatRamp_intervalShrinks()
+{
+    button_setup();
+    // intervals 200, 160, 120, 80, 40, 40ms
+    button->setLongPressRepeatRamp(200, 40, 4);
+    When(Method(ArduinoFake(), digitalRead)).AlwaysReturn(buttonActiveState); // pressed
+    simulateButtonService(ENC_HOLDTIME + 200 + 160 + 120 + 80 + 40 + 40 + 1);
+
+    TEST_ASSERT_EQUAL(Button::LongPressRepeat, button->getButton());
+    TEST_ASSERT_EQUAL(6, button->getLongPressRepeatCount());
+
+    // next repeat after minimum interval
+    simulateButtonService(40);
+    TEST_ASSERT_EQUAL(Button::LongPressRepeat, button->getButton());
+    TEST_ASSERT_EQUAL(1, button->getLongPressRepeatCount());
     button_teardown();
 }
 
+void button_longPressRepeatRamp_moreStepsThanTicks_stillRamps()
+{
+    Button::RepeatRamp ramp;
+    // 5 ticks down to 2 ticks in 8 steps
+    ramp.configure(100, 40, 8);
+    TEST_ASSERT_EQUAL(1, ramp.stepTicks);
+
+    // longer than 255 ticks
+    ramp.configure(6000, 6000, 1);
+    TEST_ASSERT_EQUAL(UINT8_MAX, ramp.startTicks);
+    TEST_ASSERT_EQUAL(UINT8_MAX, ramp.minTicks);
+}
+
 void button_doubleclickWithinTime_doubleClicked()
 {
     button_setup();
@@ -0,0 +1,168 @@
+#include <ArduinoFake.h>
+#include <ClickEncoder.h>
+#include <ClickEncoderMatrix.h>
+
+#include <unity.h>
+
+using namespace fakeit;
+
+constexpr uint8_t MATRIX_ROWS{4};
+constexpr uint8_t MATRIX_COLS{4};
+
+// simulated key matrix: column bits read on the selected row, active low
+static uint16_t readRows[MATRIX_ROWS]{};
+static uint8_t selectedRow{0};
+static uint8_t rowSelectCount[MATRIX_ROWS]{};
+
+void simulateSelectRow(uint8_t row)
+{
+    selectedRow = row;
+    ++rowSelectCount[row];
+}
+
+uint16_t simulateReadColumns()
+{
+    return ~readRows[selectedRow];
+}
+
+void simulatePress(uint8_t row, uint8_t col, bool pressed)
+{
+    if (pressed)
+    {
+        readRows[row] |= (1 << col);
+    }
+    else
+    {
+        readRows[row] &= ~(1 << col);
+    }
+}
+
+void simulateMatrixService(ButtonMatrix<MATRIX_ROWS, MATRIX_COLS> &matrix, uint16_t millisec)
+{
+    for (uint16_t i = 0; i < millisec; ++i)
+    {
+        matrix.service();
+    }
+}
+
+void buttonMatrix_setup()
+{
+    for (uint8_t row = 0; row < MATRIX_ROWS; ++row)
+    {
+        readRows[row] = 0;
+        rowSelectCount[row] = 0;
+    }
+}
+
+void buttonMatrix_service_selectsEveryRowOncePerInterval()
+{
+    buttonMatrix_setup();
+    ButtonMatrix<MATRIX_ROWS, MATRIX_COLS> matrix{simulateSelectRow, simulateReadColumns};
+
+    simulateMatrixService(matrix, ENC_BUTTONINTERVAL * 3);
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; ++row)
+    {
+        TEST_ASSERT_EQUAL(3, rowSelectCount[row]);
+    }
+}
+
+// one row per call, no idle tick: counts reads of a row other than the selected one
+static int16_t fullSelectedRow{-1};
+static uint8_t fullRowsRead{0};
+static uint8_t fullUnselectedReads{0};
+
+void fullSelectRow(uint8_t row)
+{
+    fullSelectedRow = row;
+}
+
+uint16_t fullReadColumns()
+{
+    if (fullSelectedRow != fullRowsRead % ENC_BUTTONINTERVAL)
+    {
+        ++fullUnselectedReads;
+    }
+    ++fullRowsRead;
+    return 0xFFFF;
+}
+
+void buttonMatrix_rowsEqualInterval_readsSelectedRowsOnly()
+{
+    ButtonMatrix<ENC_BUTTONINTERVAL, 1> matrix{fullSelectRow, fullReadColumns};
+
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL * 2; ++i)
+    {
+        matrix.service();
+    }
+
+    TEST_ASSERT_EQUAL(ENC_BUTTONINTERVAL * 2 - 1, fullRowsRead);
+    TEST_ASSERT_EQUAL(0, fullUnselectedReads);
+}
+
+void buttonMatrix_keyPressRelease_Clicked()
+{
+    buttonMatrix_setup();
+    ButtonMatrix<MATRIX_ROWS, MATRIX_COLS> matrix{simulateSelectRow, simulateReadColumns};
+
+    simulatePress(1, 2, true);
+    simulateMatrixService(matrix, ENC_BUTTONINTERVAL * 2);
+    TEST_ASSERT_TRUE(matrix.isPressed(1, 2));
+    simulatePress(1, 2, false);
+    simulateMatrixService(matrix, ENC_BUTTONINTERVAL);
+
+    TEST_ASSERT_EQUAL(Button::Clicked, matrix.getButton(1, 2));
+    TEST_ASSERT_EQUAL(Button::Open, matrix.getButton(2, 1));
+}
+
+void buttonMatrix_keyHeldAboveThreshold_Held()
+{
+    buttonMatrix_setup();
+    ButtonMatrix<MATRIX_ROWS, MATRIX_COLS> matrix{simulateSelectRow, simulateReadColumns};
+
+    simulatePress(3, 0, true);
+    simulateMatrixService(matrix, ENC_HOLDTIME + ENC_BUTTONINTERVAL);
+
+    TEST_ASSERT_EQUAL(Button::Held, matrix.getButton(3, 0));
+}
+
+void buttonMatrix_doubleclickWithinTime_DoubleClicked()
+{
+    buttonMatrix_setup();
+    ButtonMatrix<MATRIX_ROWS, MATRIX_COLS> matrix{simulateSelectRow, simulateReadColumns};
+    matrix.setDoubleClickEnabled(true);
+
+    simulatePress(0, 3, true);
+    simulateMatrixService(matrix, ENC_BUTTONINTERVAL * 2);
+    simulatePress(0, 3, false);
+    simulateMatrixService(matrix, ENC_BUTTONINTERVAL);
+    simulatePress(0, 3, true);
+    simulateMatrixService(matrix, ENC_BUTTONINTERVAL);
+    simulatePress(0, 3, false);
+    simulateMatrixService(matrix, ENC_BUTTONINTERVAL);
+
+    TEST_ASSERT_EQUAL(Button::DoubleClicked, matrix.getButton(0, 3));
+}
+
+void buttonMatrix_rectangleOfKeys_ghostingFlagged()
+{
+    buttonMatrix_setup();
+    ButtonMatrix<MATRIX_ROWS, MATRIX_COLS> matrix{simulateSelectRow, simulateReadColumns};
+
+    simulatePress(0, 0, true);
+    simulatePress(0, 1, true);
+    simulateMatrixService(matrix, ENC_BUTTONINTERVAL);
+    // pressing (1, 0) makes (1, 1) read as pressed, too
+    simulatePress(1, 0, true);
+    simulatePress(1, 1, true);
+    simulateMatrixService(matrix, ENC_BUTTONINTERVAL);
+
+    TEST_ASSERT_TRUE(matrix.hasGhosting());
+    TEST_ASSERT_FALSE(matrix.isPressed(1, 1));
+    TEST_ASSERT_TRUE(matrix.isPressed(0, 1));
+
+    simulatePress(1, 0, false);
+    simulatePress(1, 1, false);
+    simulateMatrixService(matrix, ENC_BUTTONINTERVAL);
+    TEST_ASSERT_FALSE(matrix.hasGhosting());
+}
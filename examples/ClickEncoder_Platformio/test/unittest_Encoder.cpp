@@ -310,4 +310,227 @@ void encoder_moreStepsPerNotch_acceleratesCorrectly()
     twoStep.service(); // one notch with acceleration turned
 
     TEST_ASSERT_EQUAL(-(ENC_ACCEL_START / ENC_ACCEL_SLOPE + 1), twoStep.getIncrement());
-}
\ No newline at end of file
+}
+
+void encoder_skipRecovery_jumpAfterClockwise_getIncrement3()
+{
+    encoder_setup();
+    encoder->setSkipRecoveryEnabled(true);
+
+    // 0 --> 1 (+1), then jump 1 --> 3 while turning clockwise (+2)
+    When(Method(ArduinoFake(), digitalRead).Using(pinA)).AlwaysReturn(pinActiveState);
+    When(Method(ArduinoFake(), digitalRead).Using(pinB)).AlwaysReturn(pinActiveState);
+    encoder->service();
+    When(Method(ArduinoFake(), digitalRead).Using(pinB)).AlwaysReturn(!pinActiveState);
+    encoder->service();
+    When(Method(ArduinoFake(), digitalRead).Using(pinA)).AlwaysReturn(!pinActiveState);
+    When(Method(ArduinoFake(), digitalRead).Using(pinB)).AlwaysReturn(pinActiveState);
+    encoder->service();
+
+    TEST_ASSERT_EQUAL(3, encoder->getIncrement());
+    TEST_ASSERT_EQUAL(1, encoder->getInferredSteps());
+    encoder_teardown();
+}
+
+void encoder_skipRecovery_jumpAfterCounterClockwise_getDecrement3()
+{
+    encoder_setup();
+    encoder->setSkipRecoveryEnabled(true);
+
+    // 0 --> 3 (-1), then jump 3 --> 1 while turning counterclockwise (-2)
+    When(Method(ArduinoFake(), digitalRead).Using(pinA)).AlwaysReturn(pinActiveState);
+    When(Method(ArduinoFake(), digitalRead).Using(pinB)).AlwaysReturn(pinActiveState);
+    encoder->service();
+    When(Method(ArduinoFake(), digitalRead).Using(pinA)).AlwaysReturn(!pinActiveState);
+    encoder->service();
+    When(Method(ArduinoFake(), digitalRead).Using(pinA)).AlwaysReturn(pinActiveState);
+    When(Method(ArduinoFake(), digitalRead).Using(pinB)).AlwaysReturn(!pinActiveState);
+    encoder->service();
+
+    TEST_ASSERT_EQUAL(-3, encoder->getIncrement());
+    TEST_ASSERT_EQUAL(1, encoder->getInferredSteps());
+    encoder_teardown();
+}
+
+void encoder_skipRecovery_jumpAfterTimeout_getDecrement2()
+{
+    encoder_setup();
+    encoder->setSkipRecoveryEnabled(true);
+
+    When(Method(ArduinoFake(), digitalRead).Using(pinA)).AlwaysReturn(pinActiveState);
+    When(Method(ArduinoFake(), digitalRead).Using(pinB)).AlwaysReturn(pinActiveState);
+    encoder->service();
+    When(Method(ArduinoFake(), digitalRead).Using(pinB)).AlwaysReturn(!pinActiveState);
+    simulateEncoderService(ENC_SKIPRECOVERY_TIMEOUT); // direction of last move is outdated
+    encoder->getIncrement();
+    When(Method(ArduinoFake(), digitalRead).Using(pinA)).AlwaysReturn(!pinActiveState);
+    When(Method(ArduinoFake(), digitalRead).Using(pinB)).AlwaysReturn(pinActiveState);
+    encoder->service();
+
+    TEST_ASSERT_EQUAL(-2, encoder->getIncrement());
+    TEST_ASSERT_EQUAL(0, encoder->getInferredSteps());
+    encoder_teardown();
+}
+
+void encoder_fourStepsPerNotch_turn3Steps_getPosition3Quarters()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Encoder fourStep{pinA, pinB, 4, pinActiveState};
+
+    // 0 --> 3 (+3), no full notch yet
+    When(Method(ArduinoFake(), digitalRead).Using(pinA)).AlwaysReturn(pinActiveState);
+    When(Method(ArduinoFake(), digitalRead).Using(pinB)).AlwaysReturn(pinActiveState);
+    fourStep.service();
+    When(Method(ArduinoFake(), digitalRead).Using(pinB)).AlwaysReturn(!pinActiveState);
+    fourStep.service();
+    When(Method(ArduinoFake(), digitalRead).Using(pinA)).AlwaysReturn(!pinActiveState);
+    fourStep.service();
+    When(Method(ArduinoFake(), digitalRead).Using(pinB)).AlwaysReturn(pinActiveState);
+    fourStep.service();
+
+    TEST_ASSERT_EQUAL(0, fourStep.getAccumulate());
+    TEST_ASSERT_EQUAL(3 * 256 / 4, fourStep.getPosition());
+    TEST_ASSERT_EQUAL(3 * 256 / 4, fourStep.getFractionalIncrement());
+    TEST_ASSERT_EQUAL(0, fourStep.getFractionalIncrement());
+}
+
+void encoder_threeStepsPerNotch_turn1StepBack_getFractionalDecrement()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Encoder threeStep{pinA, pinB, 3, pinActiveState};
+
+    // 3 <-- 0 (-1)
+    When(Method(ArduinoFake(), digitalRead).Using(pinA)).AlwaysReturn(pinActiveState);
+    When(Method(ArduinoFake(), digitalRead).Using(pinB)).AlwaysReturn(pinActiveState);
+    threeStep.service();
+    When(Method(ArduinoFake(), digitalRead).Using(pinA)).AlwaysReturn(!pinActiveState);
+    threeStep.service();
+
+    TEST_ASSERT_EQUAL(-256 / 3, threeStep.getFractionalIncrement());
+    TEST_ASSERT_EQUAL(-256 / 3, threeStep.getPosition());
+}
+
+void encoder_threeStepsPerNotch_beyond2pow23Steps_getPositionExact()
+{
+    Encoder threeStep{SAMPLED_ELSEWHERE, 3, HIGH};
+
+    // 2^24 + 1 steps: Q8.8 position still fits, steps * 256 would not
+    static const bool LEVELS_A[4]{LOW, LOW, HIGH, HIGH};
+    static const bool LEVELS_B[4]{LOW, HIGH, HIGH, LOW};
+    for (uint32_t step = 1; step <= (1UL << 24) + 1; ++step)
+    {
+        threeStep.update(LEVELS_A[step & 3], LEVELS_B[step & 3]);
+    }
+
+    TEST_ASSERT_EQUAL(static_cast<int32_t>(((1L << 24) / 3) * 256 + (2 * 256) / 3), threeStep.getPosition());
+}
+
+void encoder_threeStepsPerNotch_poll3Times1Step_getFractionalIncrementSumsToNotch()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Encoder threeStep{pinA, pinB, 3, HIGH};
+
+    // 0 --> 1 --> 2 --> 3, polled after every step
+    static const bool LEVELS_A[3]{LOW, HIGH, HIGH};
+    static const bool LEVELS_B[3]{HIGH, HIGH, LOW};
+    int32_t sum{0};
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        threeStep.service(LEVELS_A[i], LEVELS_B[i]);
+        sum += threeStep.getFractionalIncrement();
+    }
+
+    TEST_ASSERT_EQUAL(256, sum);
+    TEST_ASSERT_EQUAL(256, threeStep.getPosition());
+}
+
+static void turnSteps(Encoder &enc, uint16_t steps, uint8_t fromCode = 0)
+{
+    // GrayCode sequence, clockwise
+    static const bool LEVELS_A[4]{LOW, LOW, HIGH, HIGH};
+    static const bool LEVELS_B[4]{LOW, HIGH, HIGH, LOW};
+    for (uint16_t i = fromCode + 1; i <= fromCode + steps; ++i)
+    {
+        enc.service(LEVELS_A[i & 3], LEVELS_B[i & 3]);
+    }
+}
+
+void encoder_turnBeyondInt16Range_getIncrementCorrect()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Encoder oneStep{pinA, pinB, 1, HIGH};
+
+    turnSteps(oneStep, 30000);
+    TEST_ASSERT_EQUAL(30000, oneStep.getIncrement());
+    turnSteps(oneStep, 30000);
+
+    TEST_ASSERT_EQUAL(30000, oneStep.getIncrement());
+    TEST_ASSERT_EQUAL(60000, oneStep.getAccumulate());
+}
+
+void encoder_boundValue_saturatesAtLimits()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Encoder oneStep{pinA, pinB, 1, HIGH};
+    volatile int16_t value{1000};
+    oneStep.bindValue(&value, 0, 100, 10);
+    // starts within range
+    TEST_ASSERT_EQUAL(100, value);
+
+    value = 85;
+    turnSteps(oneStep, 3);
+
+    TEST_ASSERT_EQUAL(100, value);
+}
+
+void encoder_boundValue_wrapsAround()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Encoder oneStep{pinA, pinB, 1, HIGH};
+    volatile int16_t value{8};
+    oneStep.bindValue(&value, 0, 9, 1, true);
+
+    turnSteps(oneStep, 3);
+
+    TEST_ASSERT_EQUAL(1, value);
+}
+
+void encoder_boundValue_maxBelowMin_swapped()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Encoder oneStep{pinA, pinB, 1, HIGH};
+    volatile int16_t value{8};
+    oneStep.bindValue(&value, 9, 0, 1, true);
+
+    turnSteps(oneStep, 3);
+
+    TEST_ASSERT_EQUAL(1, value);
+}
+
+void encoderCursor_twoReaders_eachGetFullIncrement()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Encoder oneStep{pinA, pinB, 1, HIGH};
+    EncoderCursor ui{oneStep};
+    EncoderCursor logger{oneStep};
+
+    turnSteps(oneStep, 3);
+    TEST_ASSERT_EQUAL(3, ui.getIncrement());
+    turnSteps(oneStep, 2, 3);
+
+    TEST_ASSERT_EQUAL(2, ui.getIncrement());
+    TEST_ASSERT_EQUAL(5, logger.getIncrement());
+    // default cursor is independent as well
+    TEST_ASSERT_EQUAL(5, oneStep.getIncrement());
+}
+
+void encoderCursor_createdAfterTurn_startsAtCurrentPosition()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Encoder oneStep{pinA, pinB, 1, HIGH};
+
+    turnSteps(oneStep, 3);
+    EncoderCursor late{oneStep};
+
+    TEST_ASSERT_EQUAL(0, late.getIncrement());
+}
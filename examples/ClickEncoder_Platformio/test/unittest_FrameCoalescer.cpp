@@ -0,0 +1,127 @@
+#include <ArduinoFake.h>
+#include <ClickEncoderCoalescer.h>
+
+#include <unity.h>
+
+using namespace fakeit;
+
+void frameCoalescer_fastSpin_netIncrementAndPeakVelocity()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Encoder enc{5, 6, 1, HIGH};
+    FrameCoalescer<1, 0> coalescer;
+    coalescer.add(enc);
+    FrameCoalescer<1, 0>::Frame frame;
+
+    // GrayCode sequence: one step every 4ms, then every 2ms
+    static const bool LEVELS_A[4]{LOW, LOW, HIGH, HIGH};
+    static const bool LEVELS_B[4]{LOW, HIGH, HIGH, LOW};
+    uint8_t step{0};
+    for (uint8_t tick = 1; tick <= 40; ++tick)
+    {
+        if ((tick % ((tick <= 20) ? 4 : 2)) == 0)
+        {
+            ++step;
+        }
+        enc.service(LEVELS_A[step & 3], LEVELS_B[step & 3]);
+        coalescer.collect();
+    }
+    coalescer.takeFrame(frame);
+
+    TEST_ASSERT_EQUAL(15, frame.encoders[0].increment);
+    TEST_ASSERT_EQUAL(500, frame.encoders[0].peakVelocity);
+
+    // next frame starts empty
+    coalescer.collect();
+    coalescer.takeFrame(frame);
+    TEST_ASSERT_EQUAL(0, frame.encoders[0].increment);
+    TEST_ASSERT_EQUAL(0, frame.encoders[0].peakVelocity);
+}
+
+void frameCoalescer_clickThenPressAgain_orderedEvents()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Button btn{4, LOW};
+    FrameCoalescer<0, 1> coalescer;
+    coalescer.add(btn);
+    FrameCoalescer<0, 1>::Frame frame;
+
+    When(Method(ArduinoFake(), digitalRead).Using(4)).AlwaysReturn(LOW); // pressed
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL; ++i)
+    {
+        coalescer.service();
+    }
+    When(Method(ArduinoFake(), digitalRead).Using(4)).AlwaysReturn(HIGH); // released
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL; ++i)
+    {
+        coalescer.service();
+    }
+    When(Method(ArduinoFake(), digitalRead).Using(4)).AlwaysReturn(LOW); // pressed again
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL; ++i)
+    {
+        coalescer.service();
+    }
+    coalescer.takeFrame(frame);
+
+    // Closed is read on every tick while pressed, listed once per press
+    TEST_ASSERT_EQUAL(3, frame.buttons[0].getEventCount());
+    TEST_ASSERT_EQUAL(Button::Closed, frame.buttons[0].getEvent(0));
+    TEST_ASSERT_EQUAL(Button::Clicked, frame.buttons[0].getEvent(1));
+    TEST_ASSERT_EQUAL(Button::Closed, frame.buttons[0].getEvent(2));
+    TEST_ASSERT_TRUE(frame.buttons[0].contains(Button::Clicked));
+    TEST_ASSERT_FALSE(frame.buttons[0].contains(Button::Held));
+}
+
+void frameCoalescer_eventAfterFlip_inNextFrame()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Button btn{4, LOW};
+    FrameCoalescer<0, 1> coalescer;
+    coalescer.add(btn);
+    FrameCoalescer<0, 1>::Frame frame;
+
+    When(Method(ArduinoFake(), digitalRead).Using(4)).AlwaysReturn(HIGH); // not pressed
+    coalescer.service();
+    coalescer.takeFrame(frame);
+    TEST_ASSERT_EQUAL(0, frame.buttons[0].getEventCount());
+
+    When(Method(ArduinoFake(), digitalRead).Using(4)).AlwaysReturn(LOW); // pressed
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL; ++i)
+    {
+        coalescer.service();
+    }
+    coalescer.takeFrame(frame);
+    TEST_ASSERT_EQUAL(1, frame.buttons[0].getEventCount());
+    TEST_ASSERT_EQUAL(Button::Closed, frame.buttons[0].getEvent(0));
+}
+
+void frameCoalescer_holdRepeatRelease_repeatsCountedThenReleased()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Button btn{4, LOW};
+    btn.setLongPressRepeatEnabled(true);
+    btn.setLongPressRepeatRamp(ENC_BUTTONINTERVAL, ENC_BUTTONINTERVAL, 1);
+    FrameCoalescer<0, 1> coalescer;
+    coalescer.add(btn);
+    FrameCoalescer<0, 1>::Frame frame;
+
+    // held: first repeat one interval after Held, then one per interval
+    When(Method(ArduinoFake(), digitalRead).Using(4)).AlwaysReturn(LOW); // pressed
+    for (uint16_t i = 0; i < ENC_HOLDTIME + 5 * ENC_BUTTONINTERVAL; ++i)
+    {
+        coalescer.service();
+    }
+    When(Method(ArduinoFake(), digitalRead).Using(4)).AlwaysReturn(HIGH); // released
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL; ++i)
+    {
+        coalescer.service();
+    }
+    coalescer.takeFrame(frame);
+
+    TEST_ASSERT_EQUAL(4, frame.buttons[0].getEventCount());
+    TEST_ASSERT_EQUAL(Button::Closed, frame.buttons[0].getEvent(0));
+    TEST_ASSERT_EQUAL(Button::Held, frame.buttons[0].getEvent(1));
+    TEST_ASSERT_EQUAL(Button::LongPressRepeat, frame.buttons[0].getEvent(2));
+    TEST_ASSERT_EQUAL(Button::Released, frame.buttons[0].getEvent(3));
+    TEST_ASSERT_EQUAL(5, frame.buttons[0].getLongPressRepeatCount());
+}
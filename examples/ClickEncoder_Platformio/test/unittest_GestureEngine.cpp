@@ -0,0 +1,165 @@
+#include <ArduinoFake.h>
+#include <ClickEncoder.h>
+
+#include <unity.h>
+
+using namespace fakeit;
+
+static void serviceFor(ClickEncoder &clickEnc, uint16_t ms)
+{
+    for (uint16_t i = 0; i < ms; ++i)
+    {
+        clickEnc.service();
+    }
+}
+
+static void setPressed(bool pressed)
+{
+    When(Method(ArduinoFake(), digitalRead).Using(7)).AlwaysReturn(pressed ? LOW : HIGH);
+}
+
+static void click(ClickEncoder &clickEnc)
+{
+    setPressed(true);
+    serviceFor(clickEnc, ENC_BUTTONINTERVAL);
+    setPressed(false);
+    serviceFor(clickEnc, ENC_BUTTONINTERVAL);
+}
+
+static void setupClickEncoder()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    When(Method(ArduinoFake(), digitalRead).Using(5)).AlwaysReturn(LOW);
+    When(Method(ArduinoFake(), digitalRead).Using(6)).AlwaysReturn(LOW);
+    setPressed(false);
+}
+
+void gestureEngine_singleClick_ClickAfterGapTime()
+{
+    setupClickEncoder();
+    ClickEncoder clickEnc{5, 6, 7, 2, LOW};
+    clickEnc.setGesturesEnabled(true);
+
+    click(clickEnc);
+    // may still become a multi-click
+    TEST_ASSERT_EQUAL(GestureEngine::NoGesture, clickEnc.getGesture());
+    serviceFor(clickEnc, ENC_CLICKGAPTIME);
+
+    TEST_ASSERT_EQUAL(GestureEngine::Click, clickEnc.getGesture());
+    TEST_ASSERT_EQUAL(GestureEngine::NoGesture, clickEnc.getGesture());
+}
+
+void gestureEngine_doubleClick_DoubleClickAfterGapTime()
+{
+    setupClickEncoder();
+    ClickEncoder clickEnc{5, 6, 7, 2, LOW};
+    clickEnc.setGesturesEnabled(true);
+
+    click(clickEnc);
+    click(clickEnc);
+    serviceFor(clickEnc, ENC_CLICKGAPTIME);
+
+    TEST_ASSERT_EQUAL(GestureEngine::DoubleClick, clickEnc.getGesture());
+}
+
+void gestureEngine_tripleClick_TripleClickOnRelease()
+{
+    setupClickEncoder();
+    ClickEncoder clickEnc{5, 6, 7, 2, LOW};
+    clickEnc.setGesturesEnabled(true);
+
+    click(clickEnc);
+    click(clickEnc);
+    click(clickEnc);
+
+    // no further clicks possible: reported without waiting for the gap
+    TEST_ASSERT_EQUAL(GestureEngine::TripleClick, clickEnc.getGesture());
+}
+
+void gestureEngine_heldAboveThreshold_Hold()
+{
+    setupClickEncoder();
+    ClickEncoder clickEnc{5, 6, 7, 2, LOW};
+    clickEnc.setGesturesEnabled(true);
+
+    setPressed(true);
+    serviceFor(clickEnc, ENC_HOLDTIME);
+    TEST_ASSERT_EQUAL(GestureEngine::NoGesture, clickEnc.getGesture());
+    serviceFor(clickEnc, ENC_BUTTONINTERVAL);
+    TEST_ASSERT_EQUAL(GestureEngine::Hold, clickEnc.getGesture());
+
+    setPressed(false);
+    serviceFor(clickEnc, ENC_BUTTONINTERVAL + ENC_CLICKGAPTIME);
+    TEST_ASSERT_EQUAL(GestureEngine::NoGesture, clickEnc.getGesture());
+}
+
+void gestureEngine_pressAndTurn_PressAndTurnNoClick()
+{
+    setupClickEncoder();
+    ClickEncoder clickEnc{5, 6, 7, 2, LOW};
+    clickEnc.setGesturesEnabled(true);
+
+    setPressed(true);
+    serviceFor(clickEnc, ENC_BUTTONINTERVAL);
+    // 0 --> 1 --> 2: one notch
+    When(Method(ArduinoFake(), digitalRead).Using(6)).AlwaysReturn(HIGH);
+    clickEnc.service();
+    When(Method(ArduinoFake(), digitalRead).Using(5)).AlwaysReturn(HIGH);
+    clickEnc.service();
+
+    TEST_ASSERT_EQUAL(GestureEngine::PressAndTurn, clickEnc.getGesture());
+    TEST_ASSERT_EQUAL(1, clickEnc.getIncrement());
+
+    setPressed(false);
+    serviceFor(clickEnc, ENC_BUTTONINTERVAL + ENC_CLICKGAPTIME);
+    TEST_ASSERT_EQUAL(GestureEngine::NoGesture, clickEnc.getGesture());
+}
+
+void buttonChord_bothPressedWithinTime_Chord()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Button first{7, LOW};
+    Button second{8, LOW};
+    ButtonChord chord{first, second};
+
+    When(Method(ArduinoFake(), digitalRead).Using(7)).AlwaysReturn(LOW);
+    When(Method(ArduinoFake(), digitalRead).Using(8)).AlwaysReturn(HIGH);
+    first.service();
+    second.service();
+    chord.service();
+    When(Method(ArduinoFake(), digitalRead).Using(8)).AlwaysReturn(LOW);
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL; ++i)
+    {
+        first.service();
+        second.service();
+        chord.service();
+    }
+
+    TEST_ASSERT_EQUAL(GestureEngine::Chord, chord.getGesture());
+}
+
+void buttonChord_secondPressedTooLate_noChord()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Button first{7, LOW};
+    Button second{8, LOW};
+    ButtonChord chord{first, second};
+
+    When(Method(ArduinoFake(), digitalRead).Using(7)).AlwaysReturn(LOW);
+    When(Method(ArduinoFake(), digitalRead).Using(8)).AlwaysReturn(HIGH);
+    for (uint8_t i = 0; i < ENC_CHORDTIME + ENC_BUTTONINTERVAL; ++i)
+    {
+        first.service();
+        second.service();
+        chord.service();
+    }
+    When(Method(ArduinoFake(), digitalRead).Using(8)).AlwaysReturn(LOW);
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL; ++i)
+    {
+        first.service();
+        second.service();
+        chord.service();
+    }
+
+    TEST_ASSERT_EQUAL(GestureEngine::NoGesture, chord.getGesture());
+}
@@ -0,0 +1,120 @@
+#ifdef __linux__
+
+#include <ArduinoFake.h>
+#include <ClickEncoder.h>
+#include <ClickEncoderLinux.h>
+
+#include <unity.h>
+#include <unistd.h>
+
+using namespace fakeit;
+
+constexpr uint32_t OFFSET_A{17};
+constexpr uint32_t OFFSET_B{18};
+constexpr uint32_t OFFSET_BTN{27};
+constexpr uint64_t START_NS{1000000000ULL};
+constexpr uint64_t MS_NS{1000000ULL};
+
+static int pipeFds[2]{-1, -1};
+
+// simulates the gpio line request file descriptor
+void writeLineEvent(uint32_t offset, bool rising, uint64_t timestampNs)
+{
+    gpio_v2_line_event event{};
+    event.timestamp_ns = timestampNs;
+    event.id = rising ? GPIO_V2_LINE_EVENT_RISING_EDGE : GPIO_V2_LINE_EVENT_FALLING_EDGE;
+    event.offset = offset;
+    TEST_ASSERT_EQUAL(sizeof(event), write(pipeFds[1], &event, sizeof(event)));
+}
+
+void gpioEventSource_setup()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    TEST_ASSERT_EQUAL(0, pipe(pipeFds));
+}
+
+void gpioEventSource_teardown()
+{
+    close(pipeFds[0]);
+    close(pipeFds[1]);
+}
+
+void gpioEventSource_noEvents_dispatchTimesOut()
+{
+    gpioEventSource_setup();
+    GpioEventSource source{pipeFds[0]};
+
+    TEST_ASSERT_TRUE(source.isValid());
+    TEST_ASSERT_EQUAL(0, source.dispatch(0));
+    gpioEventSource_teardown();
+}
+
+void gpioEventSource_oneNotchWithinOneTick_getIncrement1()
+{
+    gpioEventSource_setup();
+    GpioEventSource source{pipeFds[0]};
+    Encoder encoder{SAMPLED_ELSEWHERE, 4, LOW};
+    source.attach(encoder, OFFSET_A, OFFSET_B, LOW, LOW);
+
+    // 00 -> 01 -> 11 -> 10 -> 00, all edges within less than 1ms
+    writeLineEvent(OFFSET_B, true, START_NS);
+    writeLineEvent(OFFSET_A, true, START_NS + 100000);
+    writeLineEvent(OFFSET_B, false, START_NS + 200000);
+    writeLineEvent(OFFSET_A, false, START_NS + 300000);
+
+    TEST_ASSERT_EQUAL(4, source.dispatch(0));
+    TEST_ASSERT_EQUAL(1, encoder.getIncrement());
+    gpioEventSource_teardown();
+}
+
+void gpioEventSource_oneNotchFromPulledUpRest_getIncrement1()
+{
+    gpioEventSource_setup();
+    GpioEventSource source{pipeFds[0]};
+    Encoder encoder{SAMPLED_ELSEWHERE, 4, LOW};
+    source.attach(encoder, OFFSET_A, OFFSET_B);
+
+    // 11 -> 10 -> 00 -> 01 -> 11
+    writeLineEvent(OFFSET_B, false, START_NS);
+    writeLineEvent(OFFSET_A, false, START_NS + 100000);
+    writeLineEvent(OFFSET_B, true, START_NS + 200000);
+    writeLineEvent(OFFSET_A, true, START_NS + 300000);
+
+    TEST_ASSERT_EQUAL(4, source.dispatch(0));
+    TEST_ASSERT_EQUAL(1, encoder.getIncrement());
+    TEST_ASSERT_FALSE(source.readLevels(&OFFSET_A, 1)); // no line request
+    gpioEventSource_teardown();
+}
+
+void gpioEventSource_buttonPressRelease_Clicked()
+{
+    gpioEventSource_setup();
+    GpioEventSource source{pipeFds[0]};
+    Button button{SAMPLED_ELSEWHERE, LOW};
+    source.attach(button, OFFSET_BTN);
+
+    writeLineEvent(OFFSET_BTN, false, START_NS);
+    writeLineEvent(OFFSET_BTN, true, START_NS + 100 * MS_NS);
+    source.dispatch(0);
+    source.serviceUntil(START_NS + (100 + ENC_BUTTONINTERVAL) * MS_NS);
+
+    TEST_ASSERT_EQUAL(Button::Clicked, button.getButton());
+    gpioEventSource_teardown();
+}
+
+void gpioEventSource_buttonPressNoEvents_HeldAfterTime()
+{
+    gpioEventSource_setup();
+    GpioEventSource source{pipeFds[0]};
+    Button button{SAMPLED_ELSEWHERE, LOW};
+    source.attach(button, OFFSET_BTN);
+
+    writeLineEvent(OFFSET_BTN, false, START_NS);
+    source.dispatch(0);
+    source.serviceUntil(START_NS + (ENC_HOLDTIME + ENC_BUTTONINTERVAL) * MS_NS);
+
+    TEST_ASSERT_EQUAL(Button::Held, button.getButton());
+    gpioEventSource_teardown();
+}
+
+#endif // __linux__
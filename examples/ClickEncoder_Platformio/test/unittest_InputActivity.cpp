@@ -0,0 +1,93 @@
+#include <ArduinoFake.h>
+#include <ClickEncoder.h>
+
+#include <unity.h>
+
+using namespace fakeit;
+
+static uint8_t idleCallbackCount{0};
+
+void countIdleCallback()
+{
+    ++idleCallbackCount;
+}
+
+void inputActivity_buttonPressed_pendingAndBusy()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Button btn{5, LOW};
+    InputActivity::acknowledge();
+    uint8_t sequence = InputActivity::getSequence();
+
+    When(Method(ArduinoFake(), digitalRead)).AlwaysReturn(LOW); // pressed
+    btn.service();
+
+    TEST_ASSERT_TRUE(InputActivity::isPending());
+    TEST_ASSERT_EQUAL(sequence + 1, InputActivity::getSequence());
+    TEST_ASSERT_FALSE(InputActivity::isIdle());
+}
+
+void inputActivity_buttonOpen_notPending()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Button btn{5, LOW};
+    InputActivity::acknowledge();
+
+    When(Method(ArduinoFake(), digitalRead)).AlwaysReturn(HIGH); // not pressed
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL * 2; ++i)
+    {
+        btn.service();
+    }
+
+    TEST_ASSERT_FALSE(InputActivity::isPending());
+    TEST_ASSERT_TRUE(InputActivity::isIdle());
+}
+
+void inputActivity_clickAndDoubleClickTimeout_idleCallback()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Button btn{5, LOW};
+    btn.setDoubleClickEnabled(true);
+    idleCallbackCount = 0;
+    InputActivity::setIdleCallback(countIdleCallback);
+
+    When(Method(ArduinoFake(), digitalRead)).AlwaysReturn(LOW); // pressed
+    btn.service();
+    When(Method(ArduinoFake(), digitalRead)).AlwaysReturn(HIGH); // not pressed
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL; ++i)
+    {
+        btn.service();
+    }
+    // waits for second click
+    TEST_ASSERT_EQUAL(0, idleCallbackCount);
+
+    for (uint16_t i = 0; i < ENC_DOUBLECLICKTIME; ++i)
+    {
+        btn.service();
+    }
+    InputActivity::setIdleCallback(nullptr);
+
+    TEST_ASSERT_EQUAL(1, idleCallbackCount);
+    TEST_ASSERT_TRUE(InputActivity::isIdle());
+}
+
+void inputActivity_encoderTurnOneNotch_pendingOnce()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    Encoder enc{5, 6, 2, LOW};
+    When(Method(ArduinoFake(), digitalRead).Using(5)).AlwaysReturn(LOW);
+    When(Method(ArduinoFake(), digitalRead).Using(6)).AlwaysReturn(LOW);
+    enc.service();
+    InputActivity::acknowledge();
+    uint8_t sequence = InputActivity::getSequence();
+
+    // 0 --> 1 (half notch), 1 --> 2 (full notch)
+    When(Method(ArduinoFake(), digitalRead).Using(6)).AlwaysReturn(HIGH);
+    enc.service();
+    TEST_ASSERT_FALSE(InputActivity::isPending());
+    When(Method(ArduinoFake(), digitalRead).Using(5)).AlwaysReturn(HIGH);
+    enc.service();
+
+    TEST_ASSERT_TRUE(InputActivity::isPending());
+    TEST_ASSERT_EQUAL(sequence + 1, InputActivity::getSequence());
+}
@@ -0,0 +1,110 @@
+#if defined(__cpp_impl_coroutine)
+
+#include <ArduinoFake.h>
+#include <ClickEncoderAwait.h>
+
+#include <unity.h>
+
+using namespace fakeit;
+
+// Keeps its frame after returning, so tests can destroy it
+struct OwnedTask
+{
+    struct promise_type
+    {
+        OwnedTask get_return_object() { return {std::coroutine_handle<promise_type>::from_promise(*this)}; };
+        std::suspend_never initial_suspend() noexcept { return {}; };
+        std::suspend_always final_suspend() noexcept { return {}; };
+        void return_void(){};
+        void unhandled_exception() { std::terminate(); };
+    };
+    std::coroutine_handle<promise_type> handle;
+};
+
+static Button::eButtonStates received[8];
+static uint8_t receivedCount{0};
+static std::coroutine_handle<> victim;
+
+static OwnedTask recordButtonEvents(InputEvents &events)
+{
+    while (receivedCount < 8)
+    {
+        Button::eButtonStates state = co_await events.nextButtonEvent();
+        received[receivedCount++] = state;
+    }
+}
+
+static OwnedTask awaitOneEvent(InputEvents &events)
+{
+    Button::eButtonStates state = co_await events.nextButtonEvent();
+    received[receivedCount++] = state;
+}
+
+static OwnedTask awaitOneEventDestroyVictim(InputEvents &events)
+{
+    Button::eButtonStates state = co_await events.nextButtonEvent();
+    received[receivedCount++] = state;
+    victim.destroy();
+}
+
+static void serviceButton(Button &button, InputEvents &events, bool level, uint16_t ticks)
+{
+    for (uint16_t tick = 0; tick < ticks; ++tick)
+    {
+        button.service(level);
+        events.service();
+    }
+}
+
+void inputEvents_click_Clicked()
+{
+    Button button(SAMPLED_ELSEWHERE);
+    InputEvents events(nullptr, &button);
+    receivedCount = 0;
+    OwnedTask recorder = recordButtonEvents(events);
+
+    serviceButton(button, events, LOW, ENC_BUTTONINTERVAL);
+    serviceButton(button, events, HIGH, ENC_DOUBLECLICKTIME + ENC_BUTTONINTERVAL);
+
+    TEST_ASSERT_EQUAL(1, receivedCount);
+    TEST_ASSERT_EQUAL(Button::Clicked, received[0]);
+    recorder.handle.destroy();
+}
+
+void inputEvents_holdThreeSeconds_HeldOnceThenReleased()
+{
+    Button button(SAMPLED_ELSEWHERE);
+    button.setLongPressRepeatEnabled(false);
+    InputEvents events(nullptr, &button);
+    receivedCount = 0;
+    OwnedTask recorder = recordButtonEvents(events);
+
+    serviceButton(button, events, LOW, 3000);
+    serviceButton(button, events, HIGH, ENC_BUTTONINTERVAL);
+
+    TEST_ASSERT_EQUAL(2, receivedCount);
+    TEST_ASSERT_EQUAL(Button::Held, received[0]);
+    TEST_ASSERT_EQUAL(Button::Released, received[1]);
+    recorder.handle.destroy();
+}
+
+void inputEvents_resumedWaiterDestroysOther_otherNotResumed()
+{
+    Button button(SAMPLED_ELSEWHERE);
+    InputEvents events(nullptr, &button);
+    receivedCount = 0;
+    // linked last, resumed first
+    OwnedTask other = awaitOneEvent(events);
+    victim = other.handle;
+    OwnedTask first = awaitOneEventDestroyVictim(events);
+
+    serviceButton(button, events, LOW, ENC_BUTTONINTERVAL);
+    serviceButton(button, events, HIGH, ENC_BUTTONINTERVAL);
+
+    TEST_ASSERT_EQUAL(1, receivedCount);
+    TEST_ASSERT_TRUE(first.handle.done());
+    TEST_ASSERT_FALSE(events.isAwaited());
+    first.handle.destroy();
+}
+
+#endif // __cpp_impl_coroutine
@@ -0,0 +1,86 @@
+#include <ArduinoFake.h>
+#include <ClickEncoder.h>
+
+#include <unity.h>
+
+using namespace fakeit;
+
+void inputFilter_default_passesSamples()
+{
+    InputFilter filter;
+
+    TEST_ASSERT_EQUAL(true, filter.filter(true));
+    TEST_ASSERT_EQUAL(false, filter.filter(false));
+    TEST_ASSERT_EQUAL(false, filter.isEnabled());
+}
+
+void inputFilter_2of3_singleGlitch_suppressed()
+{
+    InputFilter filter;
+    filter.configure(3, 2, false);
+
+    TEST_ASSERT_EQUAL(false, filter.filter(true));
+    TEST_ASSERT_EQUAL(false, filter.filter(false));
+    TEST_ASSERT_EQUAL(false, filter.filter(false));
+    TEST_ASSERT_EQUAL(false, filter.filter(false));
+}
+
+void inputFilter_2of3_twoSamples_changes()
+{
+    InputFilter filter;
+    filter.configure(3, 2, false);
+
+    TEST_ASSERT_EQUAL(false, filter.filter(true));
+    TEST_ASSERT_EQUAL(false, filter.filter(false));
+    TEST_ASSERT_EQUAL(true, filter.filter(true));
+}
+
+void inputFilter_3of3_changeBack_needsAllSamples()
+{
+    InputFilter filter;
+    filter.configure(3, 3, true);
+
+    TEST_ASSERT_EQUAL(true, filter.filter(false));
+    TEST_ASSERT_EQUAL(true, filter.filter(false));
+    TEST_ASSERT_EQUAL(true, filter.filter(true));
+    TEST_ASSERT_EQUAL(true, filter.filter(false));
+    TEST_ASSERT_EQUAL(true, filter.filter(false));
+    TEST_ASSERT_EQUAL(false, filter.filter(false));
+}
+
+void inputFilter_button_glitch_staysOpen()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    When(Method(ArduinoFake(), digitalRead)).AlwaysReturn(HIGH); // not pressed
+    Button btn{5, LOW};
+    btn.setInputFilter(3, 2);
+
+    btn.service();
+    When(Method(ArduinoFake(), digitalRead)).Return(LOW); // 1ms spike
+    btn.service();
+    When(Method(ArduinoFake(), digitalRead)).AlwaysReturn(HIGH);
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL; ++i)
+    {
+        btn.service();
+    }
+
+    TEST_ASSERT_EQUAL(Button::Open, btn.getButton());
+}
+
+void inputFilter_encoder_glitch_noTurn()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    When(Method(ArduinoFake(), digitalRead).Using(5)).AlwaysReturn(LOW);
+    When(Method(ArduinoFake(), digitalRead).Using(6)).AlwaysReturn(LOW);
+    Encoder enc{5, 6, 1, LOW};
+    enc.setInputFilter(3, 2);
+
+    enc.service();
+    When(Method(ArduinoFake(), digitalRead).Using(6)).Return(HIGH); // 1ms spike
+    enc.service();
+    When(Method(ArduinoFake(), digitalRead).Using(6)).AlwaysReturn(LOW);
+    enc.service();
+    enc.service();
+
+    TEST_ASSERT_EQUAL(0, enc.getIncrement());
+}
@@ -0,0 +1,144 @@
+#include <ArduinoFake.h>
+#include <ClickEncoder.h>
+#include <ClickEncoderMCP23017.h>
+
+#include <unity.h>
+
+using namespace fakeit;
+
+// Simulated MCP23017 on a non-blocking bus, transfers take some service calls
+class SimulatedBus : public I2cBus
+{
+public:
+    bool startRead(uint8_t address, uint8_t reg, uint8_t *buffer, uint8_t length) override
+    {
+        if (pendingPolls > 0)
+        {
+            return false;
+        }
+        ++readCount;
+        readBuffer = buffer;
+        readRegister = reg;
+        readLength = length;
+        lastAddress = address;
+        pendingPolls = transferPolls;
+        return true;
+    }
+
+    eTransferStates getTransferState() override
+    {
+        if (--pendingPolls > 0)
+        {
+            return Pending;
+        }
+        for (uint8_t i = 0; i < readLength; ++i)
+        {
+            readBuffer[i] = registers[readRegister + i];
+        }
+        return Complete;
+    }
+
+    bool write(uint8_t address, uint8_t reg, const uint8_t *data, uint8_t length) override
+    {
+        lastAddress = address;
+        for (uint8_t i = 0; i < length; ++i)
+        {
+            registers[reg + i] = data[i];
+        }
+        return true;
+    }
+
+    void setPort(uint16_t levels)
+    {
+        registers[0x12] = levels & 0xFF;
+        registers[0x13] = levels >> 8;
+    }
+
+    uint8_t registers[0x16]{};
+    uint8_t transferPolls{2};
+    uint8_t pendingPolls{0};
+    uint8_t readCount{0};
+    uint8_t lastAddress{0};
+
+private:
+    uint8_t *readBuffer{nullptr};
+    uint8_t readRegister{0};
+    uint8_t readLength{0};
+};
+
+// port B bit 0 = button, port A bits 0/1 = encoder, all at rest (pulled up)
+constexpr uint16_t PORT_IDLE{0x0103};
+
+void simulateExpanderService(MCP23017Input &expander, uint16_t millisec)
+{
+    for (uint16_t i = 0; i < millisec; ++i)
+    {
+        expander.service();
+    }
+}
+
+void mcp23017Input_begin_configuresInputsPullupsAndInterrupts()
+{
+    SimulatedBus bus;
+    MCP23017Input expander{bus, 0x21};
+
+    TEST_ASSERT_TRUE(expander.begin());
+
+    TEST_ASSERT_EQUAL(0x21, bus.lastAddress);
+    TEST_ASSERT_EQUAL(0xFF, bus.registers[0x00]); // IODIRA
+    TEST_ASSERT_EQUAL(0xFF, bus.registers[0x0D]); // GPPUB
+    TEST_ASSERT_EQUAL(0xFF, bus.registers[0x05]); // GPINTENB
+    TEST_ASSERT_EQUAL(0x40, bus.registers[0x0A]); // IOCON.MIRROR
+}
+
+void mcp23017Input_noInterrupt_readsOnlyOnce()
+{
+    SimulatedBus bus;
+    bus.setPort(PORT_IDLE);
+    MCP23017Input expander{bus};
+
+    simulateExpanderService(expander, 100);
+
+    TEST_ASSERT_EQUAL(1, bus.readCount);
+}
+
+void mcp23017Input_interrupt_encoderTurn_getDecrement()
+{
+    SimulatedBus bus;
+    MCP23017Input expander{bus};
+    Encoder encoder{SAMPLED_ELSEWHERE, 1, LOW};
+    expander.attach(encoder, 0, 1);
+    bus.setPort(PORT_IDLE);
+    simulateExpanderService(expander, 10);
+    encoder.getIncrement(); // start position is no move
+
+    // 11 -> 01 -> 00 (2 steps counterclockwise)
+    bus.setPort(PORT_IDLE & ~0x0001);
+    expander.onInterrupt();
+    simulateExpanderService(expander, 3);
+    bus.setPort(PORT_IDLE & ~0x0003);
+    expander.onInterrupt();
+    simulateExpanderService(expander, 3);
+
+    TEST_ASSERT_EQUAL(-2, encoder.getIncrement());
+    TEST_ASSERT_EQUAL(3, bus.readCount);
+}
+
+void mcp23017Input_interrupt_buttonClick_Clicked()
+{
+    SimulatedBus bus;
+    MCP23017Input expander{bus};
+    Button button{SAMPLED_ELSEWHERE, LOW};
+    expander.attach(button, 8);
+    bus.setPort(PORT_IDLE);
+    simulateExpanderService(expander, ENC_BUTTONINTERVAL);
+
+    bus.setPort(PORT_IDLE & ~0x0100); // pressed
+    expander.onInterrupt();
+    simulateExpanderService(expander, ENC_BUTTONINTERVAL * 2);
+    bus.setPort(PORT_IDLE); // released
+    expander.onInterrupt();
+    simulateExpanderService(expander, ENC_BUTTONINTERVAL * 2);
+
+    TEST_ASSERT_EQUAL(Button::Clicked, button.getButton());
+}
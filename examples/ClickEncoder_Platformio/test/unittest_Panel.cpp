@@ -0,0 +1,144 @@
+#include <ArduinoFake.h>
+#include <ClickEncoderPanel.h>
+
+#include <unity.h>
+
+using namespace fakeit;
+
+static void setupPins()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    When(Method(ArduinoFake(), digitalRead)).AlwaysReturn(HIGH); // idle, buttons not pressed
+}
+
+void panel_turnTwoEncoders_snapshotIncrementsSinceLastSnapshot()
+{
+    setupPins();
+    Encoder first{5, 6, 1, LOW};
+    Encoder second{7, 8, 1, LOW};
+    Panel<2, 1> panel;
+    panel.add(first);
+    panel.add(second);
+    Panel<2, 1>::Frame frame;
+    panel.service();
+    panel.snapshot(frame);
+
+    // same tick for both: 1 step forth, 1 step back
+    When(Method(ArduinoFake(), digitalRead).Using(6)).AlwaysReturn(LOW);
+    When(Method(ArduinoFake(), digitalRead).Using(7)).AlwaysReturn(LOW);
+    panel.service();
+    panel.snapshot(frame);
+
+    TEST_ASSERT_EQUAL(2, frame.sequence);
+    TEST_ASSERT_EQUAL(1, frame.increments[0]);
+    TEST_ASSERT_EQUAL(-1, frame.increments[1]);
+
+    panel.service();
+    panel.snapshot(frame);
+    TEST_ASSERT_EQUAL(0, frame.increments[0]);
+    TEST_ASSERT_EQUAL(0, frame.increments[1]);
+}
+
+void panel_buttonClick_latchedUntilSnapshot()
+{
+    setupPins();
+    Button btn{4, LOW};
+    Panel<1, 1> panel;
+    panel.add(btn);
+    Panel<1, 1>::Frame frame;
+
+    When(Method(ArduinoFake(), digitalRead).Using(4)).AlwaysReturn(LOW); // pressed
+    panel.service();
+    When(Method(ArduinoFake(), digitalRead).Using(4)).AlwaysReturn(HIGH); // released
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL * 3; ++i)
+    {
+        panel.service();
+    }
+    panel.snapshot(frame);
+    TEST_ASSERT_EQUAL(Button::Clicked, frame.buttons[0]);
+
+    // acknowledged by the snapshot
+    panel.service();
+    panel.snapshot(frame);
+    TEST_ASSERT_EQUAL(Button::Open, frame.buttons[0]);
+}
+
+void panel_eventAfterSnapshottedFrame_keptForNextSnapshot()
+{
+    setupPins();
+    Button btn{4, LOW};
+    Panel<1, 1> panel;
+    panel.add(btn);
+    Panel<1, 1>::Frame frame;
+
+    panel.service();
+    panel.snapshot(frame);
+    // click lands in a frame after the acknowledged one
+    When(Method(ArduinoFake(), digitalRead).Using(4)).AlwaysReturn(LOW); // pressed
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL; ++i)
+    {
+        panel.service();
+    }
+    When(Method(ArduinoFake(), digitalRead).Using(4)).AlwaysReturn(HIGH); // released
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL; ++i)
+    {
+        panel.service();
+    }
+
+    panel.snapshot(frame);
+    TEST_ASSERT_EQUAL(Button::Clicked, frame.buttons[0]);
+}
+
+void panel_holdRepeatRelease_allRepeatsCountedThenReleased()
+{
+    setupPins();
+    Button btn{4, LOW};
+    Button reference{SAMPLED_ELSEWHERE};
+    btn.setLongPressRepeatEnabled(true);
+    btn.setLongPressRepeatRamp(200, 20, 9);
+    reference.setLongPressRepeatEnabled(true);
+    reference.setLongPressRepeatRamp(200, 20, 9);
+    Panel<1, 1> panel;
+    panel.add(btn);
+    Panel<1, 1>::Frame frame;
+
+    // snapshots every 100 ms, slower than the fastest repeats
+    When(Method(ArduinoFake(), digitalRead).Using(4)).AlwaysReturn(LOW); // pressed
+    uint16_t repeats = 0;
+    bool held = false;
+    for (uint16_t ms = 1; ms <= 3000; ++ms)
+    {
+        panel.service();
+        reference.service(LOW);
+        if ((ms % 100) == 0)
+        {
+            panel.snapshot(frame);
+            held = held || (frame.buttons[0] == Button::Held);
+            repeats += frame.repeats[0];
+        }
+    }
+    TEST_ASSERT_TRUE(held);
+    TEST_ASSERT_EQUAL(Button::LongPressRepeat, reference.getButton());
+    TEST_ASSERT_EQUAL(reference.getLongPressRepeatCount(), repeats);
+
+    When(Method(ArduinoFake(), digitalRead).Using(4)).AlwaysReturn(HIGH); // released
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL; ++i)
+    {
+        panel.service();
+    }
+    panel.snapshot(frame);
+    TEST_ASSERT_EQUAL(Button::Released, frame.buttons[0]);
+    TEST_ASSERT_EQUAL(0, frame.repeats[0]);
+}
+
+void panel_registryFull_addFails()
+{
+    setupPins();
+    Encoder enc{5, 6};
+    Button btn{4};
+    Panel<1, 0> panel;
+
+    TEST_ASSERT_TRUE(panel.add(enc));
+    TEST_ASSERT_FALSE(panel.add(enc));
+    TEST_ASSERT_FALSE(panel.add(btn));
+}
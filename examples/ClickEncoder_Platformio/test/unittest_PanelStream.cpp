@@ -0,0 +1,125 @@
+#include <ArduinoFake.h>
+#include <ClickEncoderStream.h>
+
+#include <unity.h>
+
+using namespace fakeit;
+
+typedef PanelStreamEncoder<3, 4> StreamEncoder;
+typedef PanelStreamDecoder<3, 4> StreamDecoder;
+
+void panelStream_noChanges_bitmapOnly()
+{
+    StreamEncoder encoder;
+    int16_t increments[3]{};
+    Button::eButtonStates buttons[4]{};
+    uint8_t frame[StreamEncoder::MAX_FRAME_SIZE];
+
+    TEST_ASSERT_EQUAL(1, encoder.encode(increments, buttons, frame));
+    TEST_ASSERT_EQUAL(0, frame[0]);
+}
+
+void panelStream_roundTrip_incrementsAndButtons()
+{
+    StreamEncoder encoder;
+    StreamDecoder decoder;
+    int16_t increments[3]{-1, 0, 300};
+    Button::eButtonStates buttons[4]{Button::Open, Button::Clicked, Button::Open, Button::DoubleClicked};
+    uint8_t frame[StreamEncoder::MAX_FRAME_SIZE];
+
+    uint16_t length = encoder.encode(increments, buttons, frame);
+    // bitmap, -1 --> 1 byte, 300 --> 2 bytes, 2 button codes --> 1 byte
+    TEST_ASSERT_EQUAL(5, length);
+
+    int16_t decodedIncrements[3];
+    Button::eButtonStates decodedButtons[4];
+    TEST_ASSERT_EQUAL(length, decoder.decode(frame, length, decodedIncrements, decodedButtons));
+    TEST_ASSERT_EQUAL_INT16_ARRAY(increments, decodedIncrements, 3);
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        TEST_ASSERT_EQUAL(buttons[i], decodedButtons[i]);
+    }
+}
+
+void panelStream_buttonKeptClosed_sentOnce()
+{
+    StreamEncoder encoder;
+    StreamDecoder decoder;
+    int16_t increments[3]{};
+    Button::eButtonStates buttons[4]{Button::Closed, Button::Open, Button::Open, Button::Open};
+    uint8_t frame[StreamEncoder::MAX_FRAME_SIZE];
+    int16_t decodedIncrements[3];
+    Button::eButtonStates decodedButtons[4];
+
+    uint16_t length = encoder.encode(increments, buttons, frame);
+    decoder.decode(frame, length, decodedIncrements, decodedButtons);
+    length = encoder.encode(increments, buttons, frame);
+
+    TEST_ASSERT_EQUAL(1, length);
+    decoder.decode(frame, length, decodedIncrements, decodedButtons);
+    TEST_ASSERT_EQUAL(Button::Closed, decodedButtons[0]);
+}
+
+void panelStream_buttonHeldThreeSeconds_HeldSentOnce()
+{
+    StreamEncoder encoder;
+    StreamDecoder decoder;
+    Button button(SAMPLED_ELSEWHERE);
+    button.setLongPressRepeatEnabled(false);
+    int16_t increments[3]{};
+    Button::eButtonStates buttons[4]{};
+    uint8_t frame[StreamEncoder::MAX_FRAME_SIZE];
+    int16_t decodedIncrements[3];
+    Button::eButtonStates decodedButtons[4];
+
+    // polled every ms, faster than ENC_BUTTONINTERVAL
+    uint8_t heldSent = 0;
+    for (uint16_t ms = 0; ms < 3000; ++ms)
+    {
+        button.service(LOW);
+        buttons[0] = button.getButton();
+        uint16_t length = encoder.encode(increments, buttons, frame);
+        decoder.decode(frame, length, decodedIncrements, decodedButtons);
+        if ((length > 1) && (decodedButtons[0] == Button::Held))
+        {
+            ++heldSent;
+        }
+    }
+
+    TEST_ASSERT_EQUAL(1, heldSent);
+    TEST_ASSERT_EQUAL(Button::Open, decodedButtons[0]);
+}
+
+void panelStream_everyLongPressRepeat_sent()
+{
+    StreamEncoder encoder;
+    int16_t increments[3]{};
+    Button::eButtonStates buttons[4]{Button::LongPressRepeat, Button::Open, Button::Open, Button::Open};
+    uint8_t frame[StreamEncoder::MAX_FRAME_SIZE];
+
+    TEST_ASSERT_EQUAL(2, encoder.encode(increments, buttons, frame));
+    TEST_ASSERT_EQUAL(2, encoder.encode(increments, buttons, frame));
+    // Open after an event is what the receiver shows anyway
+    buttons[0] = Button::Open;
+    TEST_ASSERT_EQUAL(1, encoder.encode(increments, buttons, frame));
+}
+
+void panelStream_truncatedFrame_decodeFails()
+{
+    StreamEncoder encoder;
+    StreamDecoder decoder;
+    int16_t increments[3]{1000, 0, 0};
+    Button::eButtonStates buttons[4]{Button::Clicked, Button::Open, Button::Open, Button::Open};
+    uint8_t frame[StreamEncoder::MAX_FRAME_SIZE];
+    int16_t decodedIncrements[3];
+    Button::eButtonStates decodedButtons[4];
+
+    uint16_t length = encoder.encode(increments, buttons, frame);
+    for (uint16_t available = 0; available < length; ++available)
+    {
+        TEST_ASSERT_EQUAL(0, decoder.decode(frame, available, decodedIncrements, decodedButtons));
+    }
+    TEST_ASSERT_EQUAL(length, decoder.decode(frame, length, decodedIncrements, decodedButtons));
+    TEST_ASSERT_EQUAL(1000, decodedIncrements[0]);
+    TEST_ASSERT_EQUAL(Button::Clicked, decodedButtons[0]);
+}
@@ -0,0 +1,121 @@
+#include <ArduinoFake.h>
+#include <ClickEncoder.h>
+#include <ClickEncoderShiftRegister.h>
+
+#include <unity.h>
+
+using namespace fakeit;
+
+constexpr uint8_t CHAIN_LENGTH{6};
+
+class FakeChain : public SpiBus
+{
+public:
+    void latch() override { ++latchCount; };
+
+    void transfer(uint8_t *buffer, uint8_t length) override
+    {
+        lastLength = length;
+        for (uint8_t i = 0; i < length; ++i)
+        {
+            buffer[i] = inputs[i];
+        }
+    };
+
+    void setInput(uint8_t bit, bool level)
+    {
+        if (level)
+        {
+            inputs[bit / 8] |= (1 << (bit % 8));
+        }
+        else
+        {
+            inputs[bit / 8] &= ~(1 << (bit % 8));
+        }
+    }
+
+    uint8_t inputs[CHAIN_LENGTH]{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    uint16_t latchCount{0};
+    uint8_t lastLength{0};
+};
+
+void shiftRegisterInput_service_latchesAndClocksWholeChain()
+{
+    FakeChain spi;
+    ShiftRegisterInput<CHAIN_LENGTH> chain{spi};
+
+    chain.service();
+    chain.service();
+
+    TEST_ASSERT_EQUAL(2, spi.latchCount);
+    TEST_ASSERT_EQUAL(CHAIN_LENGTH, spi.lastLength);
+}
+
+void shiftRegisterInput_encoderAcrossBytes_getIncrement()
+{
+    FakeChain spi;
+    ShiftRegisterInput<CHAIN_LENGTH> chain{spi};
+    Encoder encoder{SAMPLED_ELSEWHERE, 1, LOW};
+    chain.attach(encoder, 15, 16);
+    spi.setInput(15, LOW);
+    spi.setInput(16, LOW);
+    chain.service();
+
+    // 00 -> 01 -> 11 (2 steps clockwise)
+    spi.setInput(16, HIGH);
+    chain.service();
+    spi.setInput(15, HIGH);
+    chain.service();
+
+    TEST_ASSERT_EQUAL(2, encoder.getIncrement());
+}
+
+void shiftRegisterInput_buttonInLastRegister_Clicked()
+{
+    FakeChain spi;
+    ShiftRegisterInput<CHAIN_LENGTH> chain{spi};
+    Button button{SAMPLED_ELSEWHERE, LOW};
+    Button otherButton{SAMPLED_ELSEWHERE, LOW};
+    chain.attach(otherButton, 0);
+    chain.attach(button, 47);
+
+    spi.setInput(47, LOW); // pressed
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL; ++i)
+    {
+        chain.service();
+    }
+    spi.setInput(47, HIGH); // released
+    for (uint8_t i = 0; i < ENC_BUTTONINTERVAL; ++i)
+    {
+        chain.service();
+    }
+
+    TEST_ASSERT_EQUAL(Button::Clicked, button.getButton());
+    TEST_ASSERT_EQUAL(Button::Open, otherButton.getButton());
+}
+
+void shiftRegisterInput_channelTableFull_attachFails()
+{
+    FakeChain spi;
+    ShiftRegisterInput<1, 2> chain{spi};
+    Button first{SAMPLED_ELSEWHERE};
+    Button second{SAMPLED_ELSEWHERE};
+    Button third{SAMPLED_ELSEWHERE};
+
+    TEST_ASSERT_TRUE(chain.attach(first, 0));
+    TEST_ASSERT_TRUE(chain.attach(second, 1));
+    TEST_ASSERT_FALSE(chain.attach(third, 2));
+}
+
+void shiftRegisterInput_bitOutsideChain_attachFails()
+{
+    // instances sampled elsewhere don't configure any pin
+    FakeChain spi;
+    ShiftRegisterInput<1> chain{spi};
+    Encoder encoder{SAMPLED_ELSEWHERE};
+    Button button{SAMPLED_ELSEWHERE};
+
+    TEST_ASSERT_FALSE(chain.attach(encoder, 7, 8));
+    TEST_ASSERT_FALSE(chain.attach(button, 8));
+    TEST_ASSERT_TRUE(chain.attach(button, 7));
+}
@@ -0,0 +1,173 @@
+#include <ArduinoFake.h>
+#include <ClickEncoderTrace.h>
+
+#include <unity.h>
+
+using namespace fakeit;
+
+void traceRecorder_noChange_onlyFirstSampleRecorded()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    uint8_t buffer[16];
+    TraceRecorder recorder{buffer, sizeof(buffer)};
+    Encoder enc{5, 6, 4, LOW};
+    enc.setTraceRecorder(&recorder, 2);
+
+    for (uint8_t i = 0; i < 100; ++i)
+    {
+        recorder.tick();
+        enc.service(HIGH, LOW);
+    }
+    recorder.freeze();
+    uint8_t out[16];
+
+    // header, 1 tick since start
+    TEST_ASSERT_EQUAL(2, recorder.read(out, sizeof(out)));
+    TEST_ASSERT_EQUAL(0x80 | (2 << 3) | 0x01, out[0]);
+    TEST_ASSERT_EQUAL(1, out[1]);
+    TEST_ASSERT_EQUAL(0, recorder.read(out, sizeof(out)));
+}
+
+void traceRecorder_encoderStepAfter200Ticks_decodedWithDelta()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    uint8_t buffer[16];
+    TraceRecorder recorder{buffer, sizeof(buffer)};
+    Encoder enc{5, 6, 4, LOW};
+    enc.setTraceRecorder(&recorder, 0);
+
+    recorder.tick();
+    enc.service(LOW, LOW);
+    for (uint8_t i = 0; i < 200; ++i)
+    {
+        recorder.tick();
+        enc.service(LOW, (i == 199) ? HIGH : LOW);
+    }
+    recorder.freeze();
+    uint8_t out[16];
+    uint16_t length = recorder.read(out, sizeof(out));
+
+    // header + 1 delta byte, header + 2 delta bytes
+    TEST_ASSERT_EQUAL(5, length);
+    TraceRecorder::Transition transition;
+    uint16_t position = TraceRecorder::decode(out, length, transition);
+    TEST_ASSERT_EQUAL(0, transition.levels);
+    position += TraceRecorder::decode(out + position, length - position, transition);
+    TEST_ASSERT_EQUAL(length, position);
+    TEST_ASSERT_EQUAL(0, transition.channel);
+    TEST_ASSERT_EQUAL(0x02, transition.levels);
+    TEST_ASSERT_EQUAL(200, transition.ticks);
+}
+
+void traceRecorder_overwritten_decodeResyncsAtHeader()
+{
+    uint8_t buffer[8];
+    TraceRecorder recorder{buffer, sizeof(buffer)};
+
+    // every transition takes 3 bytes (delta 64..4095)
+    for (uint8_t i = 0; i < 20; ++i)
+    {
+        for (uint8_t t = 0; t < 100; ++t)
+        {
+            recorder.tick();
+        }
+        recorder.record(1, i & 1);
+    }
+    recorder.tick();
+    recorder.record(1, 0x03);
+    recorder.freeze();
+    uint8_t out[8];
+    uint16_t length = recorder.read(out, sizeof(out));
+    TEST_ASSERT_EQUAL(8, length);
+
+    // oldest bytes were overwritten, keep the newest transition
+    TraceRecorder::Transition transition;
+    uint16_t position{0};
+    uint16_t taken;
+    while ((taken = TraceRecorder::decode(out + position, length - position, transition)))
+    {
+        position += taken;
+    }
+    TEST_ASSERT_EQUAL(0x03, transition.levels);
+    TEST_ASSERT_EQUAL(1, transition.ticks);
+}
+
+void traceRecorder_notFrozen_readsNothing()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    uint8_t buffer[16];
+    TraceRecorder recorder{buffer, sizeof(buffer)};
+    Button btn{4, LOW};
+    btn.setTraceRecorder(&recorder, 1);
+    uint8_t out[16];
+
+    btn.service(LOW);
+    TEST_ASSERT_EQUAL(0, recorder.read(out, sizeof(out)));
+
+    // nothing consumed meanwhile
+    recorder.freeze();
+    TEST_ASSERT_EQUAL(2, recorder.read(out, sizeof(out)));
+}
+
+void traceRecorder_frozen_recordsNothingUntilRestart()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    uint8_t buffer[16];
+    TraceRecorder recorder{buffer, sizeof(buffer)};
+    Button btn{4, LOW};
+    btn.setTraceRecorder(&recorder, 1);
+    uint8_t out[16];
+
+    recorder.freeze();
+    btn.service(LOW);
+    btn.service(HIGH);
+    TEST_ASSERT_EQUAL(0, recorder.read(out, sizeof(out)));
+
+    recorder.restart();
+    btn.service(LOW);
+    recorder.freeze();
+    TEST_ASSERT_EQUAL(2, recorder.read(out, sizeof(out)));
+    TEST_ASSERT_EQUAL(0x80 | (1 << 3) | 0x00, out[0]);
+    TEST_ASSERT_EQUAL(0, out[1]);
+}
+
+void traceRecorder_deltaSplitAcrossReads_decodedWhenComplete()
+{
+    uint8_t buffer[16];
+    TraceRecorder recorder{buffer, sizeof(buffer)};
+    recorder.record(0, 0x00);
+    for (uint8_t i = 0; i < 200; ++i)
+    {
+        recorder.tick();
+    }
+    recorder.record(0, 0x01);
+    recorder.freeze();
+    uint8_t out[16];
+
+    // first transition and the first byte of the second one's delta
+    uint16_t length = recorder.read(out, 4);
+    TraceRecorder::Transition transition;
+    TEST_ASSERT_EQUAL(2, TraceRecorder::decode(out, length, transition));
+    TEST_ASSERT_EQUAL(0, TraceRecorder::decode(out + 2, length - 2, transition));
+
+    // rest of the delta arrives with the next read
+    length += recorder.read(out + length, sizeof(out) - length);
+    TEST_ASSERT_EQUAL(3, TraceRecorder::decode(out + 2, length - 2, transition));
+    TEST_ASSERT_EQUAL(0x01, transition.levels);
+    TEST_ASSERT_EQUAL(200, transition.ticks);
+}
+
+void traceRecorder_channelOutOfRange_rejected()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    uint8_t buffer[16];
+    TraceRecorder recorder{buffer, sizeof(buffer)};
+    Button btn{4, LOW};
+    ClickEncoder clickEncoder{5, 6, 4};
+
+    TEST_ASSERT_FALSE(btn.setTraceRecorder(&recorder, TRACE_MAX_CHANNELS));
+    TEST_ASSERT_TRUE(btn.setTraceRecorder(&recorder, TRACE_MAX_CHANNELS - 1));
+    // button would record as channel 16
+    TEST_ASSERT_FALSE(clickEncoder.setTraceRecorder(&recorder, TRACE_MAX_CHANNELS - 1));
+    TEST_ASSERT_TRUE(clickEncoder.setTraceRecorder(&recorder, TRACE_MAX_CHANNELS - 2));
+}
@@ -17,15 +17,21 @@ int main(int argc, char **argv)
     // Button class unit tests
     RUN_TEST(button_constructor_activeLow_SetsInputPullup);
     RUN_TEST(button_constructor_activeHigh_Input);
+    RUN_TEST(button_clickEncoderWithoutButton_service_noPinRead);
     RUN_TEST(button_notPressed_Open);
     RUN_TEST(button_pressed_Closed);
     RUN_TEST(button_pressed_release_Clicked);
     RUN_TEST(button_click_getTwice_Open);
     RUN_TEST(button_pressedBelowThreshold_Closed);
     RUN_TEST(button_heldAboveThreshold_Held);
+    RUN_TEST(button_heldAboveThreshold_readTwice_Open);
     RUN_TEST(button_heldAboveThreshold_release_Released);
+    RUN_TEST(button_heldRead_release_Released);
     RUN_TEST(button_heldUntilLongPressRepeat_LongPressRepeat);
-    RUN_TEST(button_heldUntilLongPressRepeat_keepHeld_Held);
+    RUN_TEST(button_heldUntilLongPressRepeat_keepHeld_Open);
+    RUN_TEST(button_heldUntilThreeRepeats_slowRead_repeatCount3);
+    RUN_TEST(button_longPressRepeatRamp_intervalShrinks);
+    RUN_TEST(button_longPressRepeatRamp_moreStepsThanTicks_stillRamps);
     RUN_TEST(button_doubleclickWithinTime_doubleClicked);
     RUN_TEST(button_doubleclickNotWithinTime_Clicked);
     RUN_TEST(button_longPressRepeatOff_heldUntilLongPressRepeat_Held);
@@ -48,6 +54,116 @@ int main(int argc, char **argv)
     RUN_TEST(encoder_acceleration_slowTurn);
     RUN_TEST(encoder_moreStepsPerNotch_countsCorrectly);
     RUN_TEST(encoder_moreStepsPerNotch_acceleratesCorrectly);
+    RUN_TEST(encoder_skipRecovery_jumpAfterClockwise_getIncrement3);
+    RUN_TEST(encoder_skipRecovery_jumpAfterCounterClockwise_getDecrement3);
+    RUN_TEST(encoder_skipRecovery_jumpAfterTimeout_getDecrement2);
+    RUN_TEST(encoder_fourStepsPerNotch_turn3Steps_getPosition3Quarters);
+    RUN_TEST(encoder_threeStepsPerNotch_turn1StepBack_getFractionalDecrement);
+    RUN_TEST(encoder_threeStepsPerNotch_beyond2pow23Steps_getPositionExact);
+    RUN_TEST(encoder_threeStepsPerNotch_poll3Times1Step_getFractionalIncrementSumsToNotch);
+    RUN_TEST(encoder_turnBeyondInt16Range_getIncrementCorrect);
+    RUN_TEST(encoder_boundValue_saturatesAtLimits);
+    RUN_TEST(encoder_boundValue_wrapsAround);
+    RUN_TEST(encoder_boundValue_maxBelowMin_swapped);
+    RUN_TEST(encoderCursor_twoReaders_eachGetFullIncrement);
+    RUN_TEST(encoderCursor_createdAfterTurn_startsAtCurrentPosition);
+
+    // InputFilter class unit tests
+    RUN_TEST(inputFilter_default_passesSamples);
+    RUN_TEST(inputFilter_2of3_singleGlitch_suppressed);
+    RUN_TEST(inputFilter_2of3_twoSamples_changes);
+    RUN_TEST(inputFilter_3of3_changeBack_needsAllSamples);
+    RUN_TEST(inputFilter_button_glitch_staysOpen);
+    RUN_TEST(inputFilter_encoder_glitch_noTurn);
+
+    // InputActivity unit tests
+    RUN_TEST(inputActivity_buttonPressed_pendingAndBusy);
+    RUN_TEST(inputActivity_buttonOpen_notPending);
+    RUN_TEST(inputActivity_clickAndDoubleClickTimeout_idleCallback);
+    RUN_TEST(inputActivity_encoderTurnOneNotch_pendingOnce);
+
+    // MCP23017Input unit tests
+    RUN_TEST(mcp23017Input_begin_configuresInputsPullupsAndInterrupts);
+    RUN_TEST(mcp23017Input_noInterrupt_readsOnlyOnce);
+    RUN_TEST(mcp23017Input_interrupt_encoderTurn_getDecrement);
+    RUN_TEST(mcp23017Input_interrupt_buttonClick_Clicked);
+
+    // ShiftRegisterInput unit tests
+    RUN_TEST(shiftRegisterInput_service_latchesAndClocksWholeChain);
+    RUN_TEST(shiftRegisterInput_encoderAcrossBytes_getIncrement);
+    RUN_TEST(shiftRegisterInput_buttonInLastRegister_Clicked);
+    RUN_TEST(shiftRegisterInput_channelTableFull_attachFails);
+    RUN_TEST(shiftRegisterInput_bitOutsideChain_attachFails);
+
+    // ButtonMatrix unit tests
+    RUN_TEST(buttonMatrix_service_selectsEveryRowOncePerInterval);
+    RUN_TEST(buttonMatrix_rowsEqualInterval_readsSelectedRowsOnly);
+    RUN_TEST(buttonMatrix_keyPressRelease_Clicked);
+    RUN_TEST(buttonMatrix_keyHeldAboveThreshold_Held);
+    RUN_TEST(buttonMatrix_doubleclickWithinTime_DoubleClicked);
+    RUN_TEST(buttonMatrix_rectangleOfKeys_ghostingFlagged);
+
+    // GestureEngine unit tests
+    RUN_TEST(gestureEngine_singleClick_ClickAfterGapTime);
+    RUN_TEST(gestureEngine_doubleClick_DoubleClickAfterGapTime);
+    RUN_TEST(gestureEngine_tripleClick_TripleClickOnRelease);
+    RUN_TEST(gestureEngine_heldAboveThreshold_Hold);
+    RUN_TEST(gestureEngine_pressAndTurn_PressAndTurnNoClick);
+    RUN_TEST(buttonChord_bothPressedWithinTime_Chord);
+    RUN_TEST(buttonChord_secondPressedTooLate_noChord);
+
+    // AbsoluteEncoder unit tests
+    RUN_TEST(grayCodeTable_allCodes_convertedToBinary);
+    RUN_TEST(absoluteEncoder_firstStableRead_noIncrement);
+    RUN_TEST(absoluteEncoder_turnBackAcrossWrap_getDecrement2);
+    RUN_TEST(absoluteEncoder_glitchShorterThanStableTime_ignored);
+    RUN_TEST(absoluteEncoder_activeLowPortRead_getIncrement);
+
+    // Panel unit tests
+    RUN_TEST(panel_turnTwoEncoders_snapshotIncrementsSinceLastSnapshot);
+    RUN_TEST(panel_buttonClick_latchedUntilSnapshot);
+    RUN_TEST(panel_eventAfterSnapshottedFrame_keptForNextSnapshot);
+    RUN_TEST(panel_holdRepeatRelease_allRepeatsCountedThenReleased);
+    RUN_TEST(panel_registryFull_addFails);
+
+    // FrameCoalescer unit tests
+    RUN_TEST(frameCoalescer_fastSpin_netIncrementAndPeakVelocity);
+    RUN_TEST(frameCoalescer_clickThenPressAgain_orderedEvents);
+    RUN_TEST(frameCoalescer_holdRepeatRelease_repeatsCountedThenReleased);
+    RUN_TEST(frameCoalescer_eventAfterFlip_inNextFrame);
+
+    // PanelStream unit tests
+    RUN_TEST(panelStream_noChanges_bitmapOnly);
+    RUN_TEST(panelStream_roundTrip_incrementsAndButtons);
+    RUN_TEST(panelStream_buttonKeptClosed_sentOnce);
+    RUN_TEST(panelStream_buttonHeldThreeSeconds_HeldSentOnce);
+    RUN_TEST(panelStream_everyLongPressRepeat_sent);
+    RUN_TEST(panelStream_truncatedFrame_decodeFails);
+
+    // TraceRecorder unit tests
+    RUN_TEST(traceRecorder_noChange_onlyFirstSampleRecorded);
+    RUN_TEST(traceRecorder_encoderStepAfter200Ticks_decodedWithDelta);
+    RUN_TEST(traceRecorder_overwritten_decodeResyncsAtHeader);
+    RUN_TEST(traceRecorder_notFrozen_readsNothing);
+    RUN_TEST(traceRecorder_frozen_recordsNothingUntilRestart);
+    RUN_TEST(traceRecorder_deltaSplitAcrossReads_decodedWhenComplete);
+    RUN_TEST(traceRecorder_channelOutOfRange_rejected);
+
+#if defined(__cpp_impl_coroutine)
+    // InputEvents unit tests, unittest_cpp20 environment
+    RUN_TEST(inputEvents_click_Clicked);
+    RUN_TEST(inputEvents_holdThreeSeconds_HeldOnceThenReleased);
+    RUN_TEST(inputEvents_resumedWaiterDestroysOther_otherNotResumed);
+#endif
+
+#ifdef __linux__
+    // GpioEventSource (Linux backend) unit tests
+    RUN_TEST(gpioEventSource_noEvents_dispatchTimesOut);
+    RUN_TEST(gpioEventSource_oneNotchWithinOneTick_getIncrement1);
+    RUN_TEST(gpioEventSource_oneNotchFromPulledUpRest_getIncrement1);
+    RUN_TEST(gpioEventSource_buttonPressRelease_Clicked);
+    RUN_TEST(gpioEventSource_buttonPressNoEvents_HeldAfterTime);
+#endif
 
     UNITY_END();
     return 0;
@@ -6,15 +6,21 @@
 // BUTTON
 void button_constructor_activeLow_SetsInputPullup();
 void button_constructor_activeHigh_Input();
+void button_clickEncoderWithoutButton_service_noPinRead();
 void button_notPressed_Open();
 void button_pressed_Closed();
 void button_pressedBelowThreshold_Closed();
 void button_heldAboveThreshold_Held();
 void button_pressed_release_Clicked();
 void button_click_getTwice_Open();
+void button_heldAboveThreshold_readTwice_Open();
 void button_heldAboveThreshold_release_Released();
+void button_heldRead_release_Released();
 void button_heldUntilLongPressRepeat_LongPressRepeat();
-void button_heldUntilLongPressRepeat_keepHeld_Held();
+void button_heldUntilLongPressRepeat_keepHeld_Open();
+void button_heldUntilThreeRepeats_slowRead_repeatCount3();
+void button_longPressRepeatRamp_intervalShrinks();
+void button_longPressRepeatRamp_moreStepsThanTicks_stillRamps();
 void button_doubleclickWithinTime_doubleClicked();
 void button_doubleclickNotWithinTime_Clicked();
 void button_longPressRepeatOff_heldUntilLongPressRepeat_Held();
@@ -36,6 +42,103 @@ void encoder_acceleration_quickTurn();
 void encoder_acceleration_slowTurn();
 void encoder_moreStepsPerNotch_countsCorrectly();
 void encoder_moreStepsPerNotch_acceleratesCorrectly();
+void encoder_skipRecovery_jumpAfterClockwise_getIncrement3();
+void encoder_skipRecovery_jumpAfterCounterClockwise_getDecrement3();
+void encoder_skipRecovery_jumpAfterTimeout_getDecrement2();
+void encoder_fourStepsPerNotch_turn3Steps_getPosition3Quarters();
+void encoder_threeStepsPerNotch_turn1StepBack_getFractionalDecrement();
+void encoder_threeStepsPerNotch_beyond2pow23Steps_getPositionExact();
+void encoder_threeStepsPerNotch_poll3Times1Step_getFractionalIncrementSumsToNotch();
+void encoder_turnBeyondInt16Range_getIncrementCorrect();
+void encoder_boundValue_saturatesAtLimits();
+void encoder_boundValue_wrapsAround();
+void encoder_boundValue_maxBelowMin_swapped();
+void encoderCursor_twoReaders_eachGetFullIncrement();
+void encoderCursor_createdAfterTurn_startsAtCurrentPosition();
+// INPUTFILTER
+void inputFilter_default_passesSamples();
+void inputFilter_2of3_singleGlitch_suppressed();
+void inputFilter_2of3_twoSamples_changes();
+void inputFilter_3of3_changeBack_needsAllSamples();
+void inputFilter_button_glitch_staysOpen();
+void inputFilter_encoder_glitch_noTurn();
+// INPUTACTIVITY
+void inputActivity_buttonPressed_pendingAndBusy();
+void inputActivity_buttonOpen_notPending();
+void inputActivity_clickAndDoubleClickTimeout_idleCallback();
+void inputActivity_encoderTurnOneNotch_pendingOnce();
+// MCP23017INPUT
+void mcp23017Input_begin_configuresInputsPullupsAndInterrupts();
+void mcp23017Input_noInterrupt_readsOnlyOnce();
+void mcp23017Input_interrupt_encoderTurn_getDecrement();
+void mcp23017Input_interrupt_buttonClick_Clicked();
+// SHIFTREGISTERINPUT
+void shiftRegisterInput_service_latchesAndClocksWholeChain();
+void shiftRegisterInput_encoderAcrossBytes_getIncrement();
+void shiftRegisterInput_buttonInLastRegister_Clicked();
+void shiftRegisterInput_channelTableFull_attachFails();
+void shiftRegisterInput_bitOutsideChain_attachFails();
+// BUTTONMATRIX
+void buttonMatrix_service_selectsEveryRowOncePerInterval();
+void buttonMatrix_rowsEqualInterval_readsSelectedRowsOnly();
+void buttonMatrix_keyPressRelease_Clicked();
+void buttonMatrix_keyHeldAboveThreshold_Held();
+void buttonMatrix_doubleclickWithinTime_DoubleClicked();
+void buttonMatrix_rectangleOfKeys_ghostingFlagged();
+// GESTUREENGINE
+void gestureEngine_singleClick_ClickAfterGapTime();
+void gestureEngine_doubleClick_DoubleClickAfterGapTime();
+void gestureEngine_tripleClick_TripleClickOnRelease();
+void gestureEngine_heldAboveThreshold_Hold();
+void gestureEngine_pressAndTurn_PressAndTurnNoClick();
+void buttonChord_bothPressedWithinTime_Chord();
+void buttonChord_secondPressedTooLate_noChord();
+// ABSOLUTEENCODER
+void grayCodeTable_allCodes_convertedToBinary();
+void absoluteEncoder_firstStableRead_noIncrement();
+void absoluteEncoder_turnBackAcrossWrap_getDecrement2();
+void absoluteEncoder_glitchShorterThanStableTime_ignored();
+void absoluteEncoder_activeLowPortRead_getIncrement();
+// PANEL
+void panel_turnTwoEncoders_snapshotIncrementsSinceLastSnapshot();
+void panel_buttonClick_latchedUntilSnapshot();
+void panel_eventAfterSnapshottedFrame_keptForNextSnapshot();
+void panel_holdRepeatRelease_allRepeatsCountedThenReleased();
+void panel_registryFull_addFails();
+// FRAMECOALESCER
+void frameCoalescer_fastSpin_netIncrementAndPeakVelocity();
+void frameCoalescer_clickThenPressAgain_orderedEvents();
+void frameCoalescer_holdRepeatRelease_repeatsCountedThenReleased();
+void frameCoalescer_eventAfterFlip_inNextFrame();
+// PANELSTREAM
+void panelStream_noChanges_bitmapOnly();
+void panelStream_roundTrip_incrementsAndButtons();
+void panelStream_buttonKeptClosed_sentOnce();
+void panelStream_buttonHeldThreeSeconds_HeldSentOnce();
+void panelStream_everyLongPressRepeat_sent();
+void panelStream_truncatedFrame_decodeFails();
+// TRACERECORDER
+void traceRecorder_noChange_onlyFirstSampleRecorded();
+void traceRecorder_encoderStepAfter200Ticks_decodedWithDelta();
+void traceRecorder_overwritten_decodeResyncsAtHeader();
+void traceRecorder_notFrozen_readsNothing();
+void traceRecorder_frozen_recordsNothingUntilRestart();
+void traceRecorder_deltaSplitAcrossReads_decodedWhenComplete();
+void traceRecorder_channelOutOfRange_rejected();
+#if defined(__cpp_impl_coroutine)
+// INPUTEVENTS
+void inputEvents_click_Clicked();
+void inputEvents_holdThreeSeconds_HeldOnceThenReleased();
+void inputEvents_resumedWaiterDestroysOther_otherNotResumed();
+#endif
 
+#ifdef __linux__
+// GPIOEVENTSOURCE
+void gpioEventSource_noEvents_dispatchTimesOut();
+void gpioEventSource_oneNotchWithinOneTick_getIncrement1();
+void gpioEventSource_oneNotchFromPulledUpRest_getIncrement1();
+void gpioEventSource_buttonPressRelease_Clicked();
+void gpioEventSource_buttonPressNoEvents_HeldAfterTime();
+#endif
 
 #endif // UNITTEST_BUTTON_H
\ No newline at end of file